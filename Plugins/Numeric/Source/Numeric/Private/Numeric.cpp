@@ -1,6 +1,7 @@
 // © 2024 Maximo Comperatore. All Rights Reserved.
 
 #include "Numeric.h"
+#include "NumericDispatch.h"
 
 #define LOCTEXT_NAMESPACE "FNumericModule"
 
@@ -8,6 +9,8 @@ void FNumericModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
 	
+	// Load the dispatch thresholds cached for this host, or calibrate them if enabled in the config.
+	FNumericDispatch::Startup();
 }
 
 void FNumericModule::ShutdownModule()
@@ -0,0 +1,165 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#include "NumericAppendBuffer.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	std::atomic<uint64> NextBufferId{ 1 };
+}
+
+struct alignas(PLATFORM_CACHE_LINE_SIZE) FNumericAppendBuffer::FShard
+{
+	mutable FCriticalSection Lock;
+	TArray<int32> Samples;
+	FStats Stats;
+
+	void Add(const int32* Values, int32 Count, bool bStoreSamples)
+	{
+		if (Count == 0)
+		{
+			return;
+		}
+
+		// Reduce outside the lock; only the merge into the shard needs it.
+		int64 Sum = 0;
+		int32 Min = Values[0];
+		int32 Max = Values[0];
+		for (int32 i = 0; i < Count; ++i)
+		{
+			Sum += Values[i];
+			Min = FMath::Min(Min, Values[i]);
+			Max = FMath::Max(Max, Values[i]);
+		}
+
+		FScopeLock ScopeLock(&Lock);
+		if (bStoreSamples)
+		{
+			Samples.Append(Values, Count);
+		}
+		Stats.Min = Stats.Num > 0 ? FMath::Min(Stats.Min, Min) : Min;
+		Stats.Max = Stats.Num > 0 ? FMath::Max(Stats.Max, Max) : Max;
+		Stats.Sum += Sum;
+		Stats.Num += Count;
+	}
+};
+
+FNumericAppendBuffer::FNumericAppendBuffer(bool bInStoreSamples, int32 InNumShards)
+	: NumShards(InNumShards > 0 ? InNumShards : FPlatformMisc::NumberOfCoresIncludingHyperthreads())
+	, bStoreSamples(bInStoreSamples)
+	, Id(NextBufferId.fetch_add(1, std::memory_order_relaxed))
+{
+	NumShards = FMath::Max(NumShards, 1);
+	Shards = MakeUnique<FShard[]>(NumShards);
+}
+
+FNumericAppendBuffer::~FNumericAppendBuffer() = default;
+
+FNumericAppendBuffer::FShard& FNumericAppendBuffer::GetThreadShard()
+{
+	// Each thread remembers the shard of the last few buffers it pushed to, with the most recent one checked first. The
+	// cache is a fixed ring so that threads outliving many buffers do not accumulate entries; a buffer whose entry was
+	// evicted simply hands the thread its next shard, which is still balanced, just not sticky.
+	constexpr int32 NumSlots = 8;
+	struct FThreadShards
+	{
+		uint64 Ids[NumSlots] = {};
+		int32 ShardIndices[NumSlots] = {};
+		int32 LastSlot = 0;
+		int32 NextSlot = 0;
+	};
+	static thread_local FThreadShards ThreadShards;
+
+	if (ThreadShards.Ids[ThreadShards.LastSlot] != Id)
+	{
+		int32 Slot = 0;
+		while (Slot < NumSlots && ThreadShards.Ids[Slot] != Id)
+		{
+			++Slot;
+		}
+		if (Slot == NumSlots)
+		{
+			Slot = ThreadShards.NextSlot;
+			ThreadShards.NextSlot = (Slot + 1) % NumSlots;
+			ThreadShards.Ids[Slot] = Id;
+			ThreadShards.ShardIndices[Slot] = (int32)(NextShard.fetch_add(1, std::memory_order_relaxed) % (uint32)NumShards);
+		}
+		ThreadShards.LastSlot = Slot;
+	}
+	return Shards[ThreadShards.ShardIndices[ThreadShards.LastSlot]];
+}
+
+void FNumericAppendBuffer::Push(int32 Value)
+{
+	GetThreadShard().Add(&Value, 1, bStoreSamples);
+}
+
+void FNumericAppendBuffer::Append(TArrayView<const int32> Values)
+{
+	GetThreadShard().Add(Values.GetData(), Values.Num(), bStoreSamples);
+}
+
+TArray<int32> FNumericAppendBuffer::Snapshot() const
+{
+	TArray<int32> Result;
+	for (int32 i = 0; i < NumShards; ++i)
+	{
+		FScopeLock ScopeLock(&Shards[i].Lock);
+		Result.Append(Shards[i].Samples);
+	}
+	return Result;
+}
+
+TArray<int32> FNumericAppendBuffer::Drain()
+{
+	TArray<int32> Result;
+	for (int32 i = 0; i < NumShards; ++i)
+	{
+		FScopeLock ScopeLock(&Shards[i].Lock);
+
+		// Steal the first non-empty shard's allocation instead of copying it.
+		if (Result.Num() == 0)
+		{
+			Result = MoveTemp(Shards[i].Samples);
+		}
+		else
+		{
+			Result.Append(Shards[i].Samples);
+		}
+		Shards[i].Samples.Reset();
+		Shards[i].Stats = FStats();
+	}
+	return Result;
+}
+
+FNumericAppendBuffer::FStats FNumericAppendBuffer::Reduce() const
+{
+	FStats Result;
+	for (int32 i = 0; i < NumShards; ++i)
+	{
+		FStats Stats;
+		{
+			FScopeLock ScopeLock(&Shards[i].Lock);
+			Stats = Shards[i].Stats;
+		}
+
+		if (Stats.Num > 0)
+		{
+			Result.Min = Result.Num > 0 ? FMath::Min(Result.Min, Stats.Min) : Stats.Min;
+			Result.Max = Result.Num > 0 ? FMath::Max(Result.Max, Stats.Max) : Stats.Max;
+			Result.Sum += Stats.Sum;
+			Result.Num += Stats.Num;
+		}
+	}
+	return Result;
+}
+
+void FNumericAppendBuffer::Reset()
+{
+	for (int32 i = 0; i < NumShards; ++i)
+	{
+		FScopeLock ScopeLock(&Shards[i].Lock);
+		Shards[i].Samples.Empty();
+		Shards[i].Stats = FStats();
+	}
+}
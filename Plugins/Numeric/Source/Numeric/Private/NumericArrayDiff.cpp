@@ -0,0 +1,404 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#include "NumericArrayDiff.h"
+#include "NumericBPLibrary.h"
+#include "Logging/StructuredLog.h"
+
+namespace
+{
+	/** Elements compared per memcmp when skipping common prefixes and suffixes. */
+	constexpr int32 CompareBlockNum = 16;
+
+	/** Equal gaps up to this length are folded into the surrounding hunk, as a hunk header costs about as much. */
+	constexpr int32 MergeGapNum = 2;
+
+	/** Upper bound on element comparisons spent searching for minimal edit scripts. */
+	constexpr int64 MaxDiffWork = 64 * 1024 * 1024;
+
+	/** Length of the blocks hashed to find unchanged content once the minimal script is out of reach. */
+	constexpr int32 AnchorNum = 16;
+
+	/** Multiplier of the polynomial block hash, the 64-bit FNV prime. */
+	constexpr uint64 HashMultiplier = 0x100000001B3ull;
+
+	constexpr uint64 HashMultiplierPow(int32 Exponent)
+	{
+		return Exponent == 0 ? 1 : HashMultiplier * HashMultiplierPow(Exponent - 1);
+	}
+
+	/** Weight of the element leaving the window when the block hash is rolled forward by one element. */
+	constexpr uint64 HashOutgoingWeight = HashMultiplierPow(AnchorNum - 1);
+
+	int32 CommonPrefix(const int32* A, const int32* B, int32 Num)
+	{
+		int32 i = 0;
+		while (i + CompareBlockNum <= Num && FMemory::Memcmp(A + i, B + i, CompareBlockNum * sizeof(int32)) == 0)
+		{
+			i += CompareBlockNum;
+		}
+		while (i < Num && A[i] == B[i])
+		{
+			++i;
+		}
+		return i;
+	}
+
+	int32 CommonSuffix(const int32* AEnd, const int32* BEnd, int32 Num)
+	{
+		int32 i = 0;
+		while (i + CompareBlockNum <= Num && FMemory::Memcmp(AEnd - i - CompareBlockNum, BEnd - i - CompareBlockNum, CompareBlockNum * sizeof(int32)) == 0)
+		{
+			i += CompareBlockNum;
+		}
+		while (i < Num && AEnd[-i - 1] == BEnd[-i - 1])
+		{
+			++i;
+		}
+		return i;
+	}
+
+	uint64 HashBlock(const int32* Data)
+	{
+		uint64 Hash = 0;
+		for (int32 i = 0; i < AnchorNum; ++i)
+		{
+			Hash = Hash * HashMultiplier + (uint32)Data[i];
+		}
+		return Hash;
+	}
+
+	/** Size of a patch in int32s: every hunk also stores its index and remove count. */
+	int64 PatchCost(const TArray<FNumericArrayHunk>& Hunks)
+	{
+		int64 Cost = 0;
+		for (const FNumericArrayHunk& Hunk : Hunks)
+		{
+			Cost += 2 + Hunk.Values.Num();
+		}
+		return Cost;
+	}
+
+	/** Returns the last hunk if it ends at Index, otherwise starts a new empty hunk there. */
+	FNumericArrayHunk& HunkAt(TArray<FNumericArrayHunk>& Hunks, int32 Index)
+	{
+		if (Hunks.Num() > 0 && Hunks.Last().Index + Hunks.Last().RemoveCount == Index)
+		{
+			return Hunks.Last();
+		}
+
+		FNumericArrayHunk& Hunk = Hunks.AddDefaulted_GetRef();
+		Hunk.Index = Index;
+		return Hunk;
+	}
+
+	/**
+	 * Myers' greedy diff of X and Y. Appends hunks offset by Base, or returns false if the edit distance exceeds MaxD.
+	 * Keeps a snapshot of the diagonal frontier for each edit step so the path can be recovered.
+	 */
+	bool MyersDiff(const int32* X, int32 N, const int32* Y, int32 M, int32 Base, int32 MaxD, TArray<FNumericArrayHunk>& Hunks)
+	{
+		MaxD = FMath::Min(MaxD, N + M);
+		const int32 Offset = MaxD + 1;
+		const int32 Stride = 2 * MaxD + 3;
+
+		TArray<int32> V;
+		V.SetNumZeroed(Stride);
+		TArray<int32> Trace;
+
+		int32 FoundD = -1;
+		for (int32 D = 0; D <= MaxD && FoundD < 0; ++D)
+		{
+			Trace.Append(V);
+
+			for (int32 k = -D; k <= D; k += 2)
+			{
+				int32 x = (k == -D || (k != D && V[Offset + k - 1] < V[Offset + k + 1])) ? V[Offset + k + 1] : V[Offset + k - 1] + 1;
+				int32 y = x - k;
+
+				while (x < N && y < M && X[x] == Y[y])
+				{
+					++x;
+					++y;
+				}
+
+				V[Offset + k] = x;
+				if (x >= N && y >= M)
+				{
+					FoundD = D;
+					break;
+				}
+			}
+		}
+
+		if (FoundD < 0)
+		{
+			return false;
+		}
+
+		// Walk the path backwards, recording one edit per step.
+		struct FEdit { int32 X; int32 Y; bool bInsert; };
+		TArray<FEdit> Edits;
+		Edits.Reserve(FoundD);
+
+		int32 x = N;
+		int32 y = M;
+		for (int32 D = FoundD; D > 0; --D)
+		{
+			const int32* Prev = Trace.GetData() + D * Stride + Offset;
+			const int32 k = x - y;
+			const bool bInsert = k == -D || (k != D && Prev[k - 1] < Prev[k + 1]);
+			const int32 PrevK = bInsert ? k + 1 : k - 1;
+			const int32 PrevX = Prev[PrevK];
+			const int32 PrevY = PrevX - PrevK;
+
+			Edits.Add({ PrevX, PrevY, bInsert });
+			x = PrevX;
+			y = PrevY;
+		}
+
+		for (int32 i = Edits.Num() - 1; i >= 0; --i)
+		{
+			const FEdit& Edit = Edits[i];
+			FNumericArrayHunk& Hunk = HunkAt(Hunks, Base + Edit.X);
+			if (Edit.bInsert)
+			{
+				Hunk.Values.Add(Y[Edit.Y]);
+			}
+			else
+			{
+				++Hunk.RemoveCount;
+			}
+		}
+
+		return true;
+	}
+
+	/**
+	 * Diff for equal-length ranges: replaces each run of mismatching positions in place.
+	 * @return Number of replaced elements.
+	 */
+	int32 PositionalDiff(const int32* X, const int32* Y, int32 Num, int32 Base, TArray<FNumericArrayHunk>& Hunks)
+	{
+		int32 Replaced = 0;
+
+		for (int32 i = 0; i < Num; ++i)
+		{
+			if (X[i] == Y[i])
+			{
+				continue;
+			}
+
+			// Short equal gaps are folded into the previous hunk rather than paying for a new one.
+			FNumericArrayHunk& Hunk = (Hunks.Num() > 0 && Base + i - (Hunks.Last().Index + Hunks.Last().RemoveCount) <= MergeGapNum)
+				? Hunks.Last()
+				: HunkAt(Hunks, Base + i);
+
+			while (Hunk.Index + Hunk.RemoveCount <= Base + i)
+			{
+				Hunk.Values.Add(Y[Hunk.Index + Hunk.RemoveCount - Base]);
+				++Hunk.RemoveCount;
+				++Replaced;
+			}
+		}
+
+		return Replaced;
+	}
+
+	void ReplaceRange(const int32* Y, int32 N, int32 M, int32 Base, TArray<FNumericArrayHunk>& Hunks)
+	{
+		FNumericArrayHunk& Hunk = HunkAt(Hunks, Base);
+		Hunk.RemoveCount += N;
+		Hunk.Values.Append(Y, M);
+	}
+
+	/**
+	 * Appends a minimal script for two non-empty ranges if one is found within Budget: the positional one when the
+	 * lengths match and few positions differ, otherwise Myers'. The search is charged to Budget.
+	 * @return false if neither fits, leaving Hunks unchanged.
+	 */
+	bool TryMinimalDiff(const int32* X, int32 N, const int32* Y, int32 M, int32 Base, int64& Budget, TArray<FNumericArrayHunk>& Hunks)
+	{
+		const int32 First = Hunks.Num();
+
+		// In-place replacements cost the same as Myers' remove/insert pairs, so a cheap positional script is kept as is.
+		if (N == M && PositionalDiff(X, Y, N, Base, Hunks) <= FNumericArrayDiff::MaxEditDistance / 2)
+		{
+			return true;
+		}
+		Hunks.SetNum(First);
+
+		// Bound the O((N + M) * D) search so very long ranges give up early instead of stalling.
+		const int32 MaxD = (int32)FMath::Clamp<int64>(Budget / (N + M), 1, FNumericArrayDiff::MaxEditDistance);
+		Budget -= (int64)(N + M) * MaxD;
+		if (MyersDiff(X, N, Y, M, Base, MaxD, Hunks))
+		{
+			return true;
+		}
+		Hunks.SetNum(First);
+		return false;
+	}
+
+	/** Diffs the ranges between two matches, falling back to positional replacement or to replacing the whole gap. */
+	void DiffGap(const int32* X, int32 N, const int32* Y, int32 M, int32 Base, int64& Budget, TArray<FNumericArrayHunk>& Hunks)
+	{
+		if (N > 0 && M > 0 && TryMinimalDiff(X, N, Y, M, Base, Budget, Hunks))
+		{
+			return;
+		}
+
+		if (N > 0 && N == M)
+		{
+			PositionalDiff(X, Y, N, Base, Hunks);
+		}
+		else if (N > 0 || M > 0)
+		{
+			ReplaceRange(Y, N, M, Base, Hunks);
+		}
+	}
+
+	/**
+	 * Splits the ranges at unchanged content and diffs each gap on its own. Every aligned AnchorNum-element block of X
+	 * is hashed, Y is scanned with a rolling hash, and each block found in order is extended both ways into a maximal
+	 * match. Blocks that occur more than once in X are not used, so repetitive data does not anchor to the wrong copy.
+	 */
+	void SplitAtAnchors(const int32* X, int32 N, const int32* Y, int32 M, int32 Base, int64& Budget, TArray<FNumericArrayHunk>& Hunks)
+	{
+		TMap<uint64, int32> Blocks;
+		Blocks.Reserve(N / AnchorNum);
+		for (int32 Start = 0; Start + AnchorNum <= N; Start += AnchorNum)
+		{
+			const uint64 Hash = HashBlock(X + Start);
+			if (int32* Existing = Blocks.Find(Hash))
+			{
+				*Existing = INDEX_NONE;
+			}
+			else
+			{
+				Blocks.Add(Hash, Start);
+			}
+		}
+
+		// End of the last match in each range. Matches are at least AnchorNum long, so hunks of neighbouring gaps never merge.
+		int32 XEnd = 0;
+		int32 YEnd = 0;
+
+		int32 y = 0;
+		uint64 Hash = 0;
+		bool bHashValid = false;
+		while (y + AnchorNum <= M)
+		{
+			if (!bHashValid)
+			{
+				Hash = HashBlock(Y + y);
+				bHashValid = true;
+			}
+
+			const int32* Found = Blocks.Find(Hash);
+			if (Found && *Found != INDEX_NONE && *Found >= XEnd && FMemory::Memcmp(X + *Found, Y + y, AnchorNum * sizeof(int32)) == 0)
+			{
+				int32 XStart = *Found;
+				int32 YStart = y;
+				while (XStart > XEnd && YStart > YEnd && X[XStart - 1] == Y[YStart - 1])
+				{
+					--XStart;
+					--YStart;
+				}
+
+				int32 XMatchEnd = *Found + AnchorNum;
+				int32 YMatchEnd = y + AnchorNum;
+				while (XMatchEnd < N && YMatchEnd < M && X[XMatchEnd] == Y[YMatchEnd])
+				{
+					++XMatchEnd;
+					++YMatchEnd;
+				}
+
+				DiffGap(X + XEnd, XStart - XEnd, Y + YEnd, YStart - YEnd, Base + XEnd, Budget, Hunks);
+				XEnd = XMatchEnd;
+				YEnd = YMatchEnd;
+				y = YMatchEnd;
+				bHashValid = false;
+				continue;
+			}
+
+			if (y + AnchorNum < M)
+			{
+				Hash = (Hash - (uint32)Y[y] * HashOutgoingWeight) * HashMultiplier + (uint32)Y[y + AnchorNum];
+			}
+			++y;
+		}
+
+		DiffGap(X + XEnd, N - XEnd, Y + YEnd, M - YEnd, Base + XEnd, Budget, Hunks);
+	}
+}
+
+TArray<FNumericArrayHunk> FNumericArrayDiff::Diff(TArrayView<const int32> A, TArrayView<const int32> B)
+{
+	TArray<FNumericArrayHunk> Hunks;
+
+	const int32 Prefix = CommonPrefix(A.GetData(), B.GetData(), FMath::Min(A.Num(), B.Num()));
+	const int32 Suffix = CommonSuffix(A.GetData() + A.Num(), B.GetData() + B.Num(), FMath::Min(A.Num(), B.Num()) - Prefix);
+
+	const int32* X = A.GetData() + Prefix;
+	const int32* Y = B.GetData() + Prefix;
+	const int32 N = A.Num() - Prefix - Suffix;
+	const int32 M = B.Num() - Prefix - Suffix;
+
+	if (N == 0 || M == 0)
+	{
+		if (N > 0 || M > 0)
+		{
+			ReplaceRange(Y, N, M, Prefix, Hunks);
+		}
+		return Hunks;
+	}
+
+	int64 Budget = MaxDiffWork;
+	if (!TryMinimalDiff(X, N, Y, M, Prefix, Budget, Hunks))
+	{
+		// The minimal script is out of reach, so split the range at unchanged blocks and diff the gaps between them.
+		// For equal lengths, keep whichever of that and the positional script is smaller.
+		SplitAtAnchors(X, N, Y, M, Prefix, Budget, Hunks);
+		if (N == M)
+		{
+			TArray<FNumericArrayHunk> Positional;
+			PositionalDiff(X, Y, N, Prefix, Positional);
+			if (PatchCost(Positional) < PatchCost(Hunks))
+			{
+				Hunks = MoveTemp(Positional);
+			}
+		}
+	}
+
+	// A patch is never larger than a single hunk replacing the whole changed range. The minimal script counts edited
+	// elements, not hunk headers, so many short hunks can exceed it as well.
+	if (PatchCost(Hunks) > 2 + M)
+	{
+		Hunks.Reset();
+		ReplaceRange(Y, N, M, Prefix, Hunks);
+	}
+
+	return Hunks;
+}
+
+bool FNumericArrayDiff::Apply(TArrayView<const int32> A, TArrayView<const FNumericArrayHunk> Hunks, TArray<int32>& Out)
+{
+	Out.Reset();
+
+	int32 Cursor = 0;
+	for (const FNumericArrayHunk& Hunk : Hunks)
+	{
+		if (Hunk.Index < Cursor || Hunk.RemoveCount < 0 || Hunk.Index > A.Num() - Hunk.RemoveCount)
+		{
+			UE_LOGFMT(LogArrayUtils, Warning, "ApplyPatch: Hunk at {0} removing {1} does not fit an array of {2} elements after index {3}", Hunk.Index, Hunk.RemoveCount, A.Num(), Cursor);
+			Out.Reset();
+			return false;
+		}
+
+		Out.Append(A.GetData() + Cursor, Hunk.Index - Cursor);
+		Out.Append(Hunk.Values);
+		Cursor = Hunk.Index + Hunk.RemoveCount;
+	}
+
+	Out.Append(A.GetData() + Cursor, A.Num() - Cursor);
+	return true;
+}
@@ -0,0 +1,59 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#include "NumericArrayHandle.h"
+
+FNumericArrayHandle::FNumericArrayHandle(const TArray<int32>& InArray)
+	: Storage(MakeShared<TArray<int32>, ESPMode::ThreadSafe>(InArray))
+	, Count(InArray.Num())
+{
+}
+
+FNumericArrayHandle::FNumericArrayHandle(TArray<int32>&& InArray)
+	: Count(InArray.Num())
+{
+	Storage = MakeShared<TArray<int32>, ESPMode::ThreadSafe>(MoveTemp(InArray));
+}
+
+FNumericArrayHandle FNumericArrayHandle::Slice(int32 Start, int32 InCount) const
+{
+	Start = FMath::Clamp(Start, 0, Count);
+
+	FNumericArrayHandle Result = *this;
+	Result.Offset = Offset + Start;
+	Result.Count = FMath::Clamp(InCount, 0, Count - Start);
+	return Result;
+}
+
+TArrayView<int32> FNumericArrayHandle::Mutate()
+{
+	if (Count == 0)
+	{
+		return TArrayView<int32>();
+	}
+
+	if (!Storage.IsUnique() || Offset != 0 || Count != Storage->Num())
+	{
+		Storage = MakeShared<TArray<int32>, ESPMode::ThreadSafe>(View());
+		Offset = 0;
+	}
+
+	return TArrayView<int32>(Storage->GetData(), Count);
+}
+
+TArrayView<int32> FNumericArrayHandle::Overwrite()
+{
+	if (Count == 0)
+	{
+		return TArrayView<int32>();
+	}
+
+	if (!Storage.IsUnique() || Offset != 0 || Count != Storage->Num())
+	{
+		TArray<int32> Elements;
+		Elements.SetNumUninitialized(Count);
+		Storage = MakeShared<TArray<int32>, ESPMode::ThreadSafe>(MoveTemp(Elements));
+		Offset = 0;
+	}
+
+	return TArrayView<int32>(Storage->GetData(), Count);
+}
@@ -5,6 +5,13 @@
 #include <numeric>
 #include <random>
 #include "Numeric.h"
+#include "NumericFileStream.h"
+#include "NumericCompactArray.h"
+#include "NumericMatrix.h"
+#include "NumericSort.h"
+#include "NumericTransform.h"
+#include "HAL/PlatformFileManager.h"
+#include "Algo/NoneOf.h"
 #include "Logging/StructuredLog.h"
 
 DEFINE_LOG_CATEGORY(LogArrayUtils)
@@ -49,20 +56,24 @@ bool UNumericBPLibrary::IsPermutation(const TArray<int32>& A, const TArray<int32
 
 TArray<int32> UNumericBPLibrary::EveryoneCubed(const TArray<int32>& A)
 {
-    TArray<int32> Result = A;
+	TArray<int32> Result;
+	Result.SetNumUninitialized(A.Num());
 
 	// Cube each element in the array.
-    std::transform(A.GetData(), A.GetData() + A.Num(), Result.GetData(), [](int32 n) {return n * n * n; });
-    return Result;
+	const int32* Source = A.GetData();
+	FNumericTransform::Generate(Result.GetData(), Result.Num(), [Source](int32 i) { return Source[i] * Source[i] * Source[i]; });
+	return Result;
 }
 
 TArray<int32> UNumericBPLibrary::EveryoneSquared(const TArray<int32>& A)
 {
-    TArray<int32> Result = A;
+	TArray<int32> Result;
+	Result.SetNumUninitialized(A.Num());
 
 	// Square each element in the array.
-    std::transform(A.GetData(), A.GetData() + A.Num(), Result.GetData(), [](int32 n) {return n * n; });
-    return Result;
+	const int32* Source = A.GetData();
+	FNumericTransform::Generate(Result.GetData(), Result.Num(), [Source](int32 i) { return Source[i] * Source[i]; });
+	return Result;
 }
 
 TArray<int32> UNumericBPLibrary::Sample(const TArray<int32>& A, int32 N)
@@ -180,13 +191,13 @@ TArray<int32> UNumericBPLibrary::PrevPermutation(TArray<int32> A)
 
 TArray<int32> UNumericBPLibrary::StableSortAscending(TArray<int32> A)
 {
-	Algo::StableSort(A);
+	FNumericSort::Sort(A);
 	return A;
 }
 
 TArray<int32> UNumericBPLibrary::StableSortDescending(TArray<int32> A)
 {
-	Algo::Sort(A, [](const int32& A, const int32& B) { return A > B; });
+	FNumericSort::Sort(A, true);
 	return A;
 }
 
@@ -213,34 +224,46 @@ bool UNumericBPLibrary::IsSorted(const TArray<int32>& A)
 
 int32 UNumericBPLibrary::InnerProduct(const TArray<int32>& A, const TArray<int32>& B, int32 StartIndex)
 {
+	// Wraps like the int32 sum it replaces, without the signed overflow.
 	return (A.Num() == B.Num() && A.Num() > 0 && B.Num() > 0)
-		? std::inner_product(A.GetData(), A.GetData() + A.Num(), B.GetData(), StartIndex)
+		? (int32)(uint32)(StartIndex + FNumericMatrix::Dot(A.GetData(), B.GetData(), A.Num()))
 		: -1;
 }
 
+int64 UNumericBPLibrary::InnerProduct64(const TArray<int32>& A, const TArray<int32>& B, int64 StartIndex, bool& Success)
+{
+	Success = A.Num() == B.Num();
+	if (!Success)
+	{
+		UE_LOGFMT(LogArrayUtils, Warning, "InnerProduct64: Arrays must be of equal length. A.Num() = {0}, B.Num() = {1}", A.Num(), B.Num());
+		return 0;
+	}
+
+	return StartIndex + FNumericMatrix::Dot(A.GetData(), B.GetData(), A.Num());
+}
+
 TArray<int32> UNumericBPLibrary::Clamp(const TArray<int32>& A, int32 Min, int32 Max)
 {
-	TArray<int32> B = A;
+	TArray<int32> B;
+	B.SetNumUninitialized(A.Num());
 
-	std::for_each(B.GetData(), B.GetData() + B.Num(), [Min, Max](int32& Element)
-	{
-		Element = FMath::Clamp(Element, Min, Max);
-	});
+	const int32* Source = A.GetData();
+	FNumericTransform::Generate(B.GetData(), B.Num(), [Source, Min, Max](int32 i) { return FMath::Clamp(Source[i], Min, Max); });
 
 	return B;
 }
 
 TArray<int32> UNumericBPLibrary::ClampN(const TArray<int32>& A, int32 Min, int32 Max, int32 N)
 {
-	TArray<int32> B = A;
+	TArray<int32> B;
+	B.SetNumUninitialized(A.Num());
 
-	N = FMath::Min(N, B.Num());
+	N = FMath::Clamp(N, 0, B.Num());
 
-	// Clamp the first N elements of the array.
-	std::for_each(B.GetData(), B.GetData() + N, [Min, Max](int32& Element)
-	{
-		Element = FMath::Clamp(Element, Min, Max);
-	});
+	// Clamp the first N elements of the array and copy the rest.
+	const int32* Source = A.GetData();
+	FNumericTransform::Generate(B.GetData(), N, [Source, Min, Max](int32 i) { return FMath::Clamp(Source[i], Min, Max); });
+	FMemory::Memcpy(B.GetData() + N, Source + N, (B.Num() - N) * sizeof(int32));
 
 	return B;
 }
@@ -257,29 +280,36 @@ int32 UNumericBPLibrary::Accumulate(const TArray<int32>& A)
 
 TArray<int32> UNumericBPLibrary::Fill(const TArray<int32>& A, int32 Value)
 {
-	TArray<int32> B = A;
+	// Every element is overwritten, so the input is never copied.
+	TArray<int32> B;
+	B.SetNumUninitialized(A.Num());
 
-	std::fill(B.GetData(), B.GetData() + B.Num(), Value);
+	FNumericTransform::Generate(B.GetData(), B.Num(), [Value](int32 i) { return Value; });
 
 	return B;
 }
 
 TArray<int32> UNumericBPLibrary::FillN(const TArray<int32>& A, int32 Value, int32 N)
 {
-	TArray<int32> B = A;
+	TArray<int32> B;
+	B.SetNumUninitialized(A.Num());
 
-	N = FMath::Min(N, B.Num());
+	N = FMath::Clamp(N, 0, B.Num());
 
-	std::fill_n(B.GetData(), N, Value);
+	// Only the elements past N are copied from the input.
+	FNumericTransform::Generate(B.GetData(), N, [Value](int32 i) { return Value; });
+	FMemory::Memcpy(B.GetData() + N, A.GetData() + N, (B.Num() - N) * sizeof(int32));
 
 	return B;
 }
 
 TArray<int32> UNumericBPLibrary::Iota(const TArray<int32>& A, int32 Value)
 {
-	TArray<int32> B = A;
+	// Every element is overwritten, so the input is never copied.
+	TArray<int32> B;
+	B.SetNumUninitialized(A.Num());
 
-	std::iota(B.GetData(), B.GetData() + B.Num(), Value);
+	FNumericTransform::Generate(B.GetData(), B.Num(), [Value](int32 i) { return Value + i; });
 
 	return B;
 }
@@ -366,14 +396,14 @@ int32 UNumericBPLibrary::Mismatch(const TArray<int32>& A, const TArray<int32>& B
 TArray<int32> UNumericBPLibrary::SortAscending(const TArray<int32>& A)
 {
 	TArray<int32> Result = A;
-	Algo::Sort(Result);
+	FNumericSort::Sort(Result);
 	return Result;
 }
 
 TArray<int32> UNumericBPLibrary::SortDescending(const TArray<int32>& A)
 {
 	TArray<int32> Result = A;
-	Algo::Sort(Result, [](const int32& A, const int32& B) { return A > B; });
+	FNumericSort::Sort(Result, true);
 	return Result;
 }
 
@@ -455,4 +485,880 @@ TArray<int32> UNumericBPLibrary::ArrayTake(const TArray<int32>& A, int32 N)
 {
 	N = FMath::Clamp(N, 0, A.Num());
 	return TArray<int32>(A.GetData(), N);
+}
+
+int32 UNumericBPLibrary::FileArrayMax(const FString& Path, bool& Success)
+{
+	int32 Min, Max;
+	FileArrayMinMax(Path, Min, Max, Success);
+	return Success ? Max : -1;
+}
+
+int32 UNumericBPLibrary::FileArrayMin(const FString& Path, bool& Success)
+{
+	int32 Min, Max;
+	FileArrayMinMax(Path, Min, Max, Success);
+	return Success ? Min : -1;
+}
+
+void UNumericBPLibrary::FileArrayMinMax(const FString& Path, int32& Min, int32& Max, bool& Success)
+{
+	Min = MAX_int32;
+	Max = MIN_int32;
+
+	const FNumericFileStream Stream(Path);
+	Success = Stream.ForEachChunk([&Min, &Max](const int32* Data, int32 Num, int64 FirstIndex)
+	{
+		const auto [ChunkMin, ChunkMax] = std::minmax_element(Data, Data + Num);
+		Min = FMath::Min(Min, *ChunkMin);
+		Max = FMath::Max(Max, *ChunkMax);
+		return true;
+	}) && Stream.Num() > 0;
+
+	if (!Success)
+	{
+		UE_LOGFMT(LogArrayUtils, Warning, "FileArrayMinMax: File must have at least 1 elements. Path = {0}", Path);
+		Min = 0;
+		Max = 0;
+	}
+}
+
+int64 UNumericBPLibrary::FileAccumulate(const FString& Path, bool& Success)
+{
+	int64 Sum = 0;
+
+	Success = FNumericFileStream(Path).ForEachChunk([&Sum](const int32* Data, int32 Num, int64 FirstIndex)
+	{
+		Sum = std::accumulate(Data, Data + Num, Sum);
+		return true;
+	});
+
+	return Sum;
+}
+
+int64 UNumericBPLibrary::FileCount(const FString& Path, int32 Value, bool& Success)
+{
+	int64 Total = 0;
+
+	Success = FNumericFileStream(Path).ForEachChunk([&Total, Value](const int32* Data, int32 Num, int64 FirstIndex)
+	{
+		Total += std::count(Data, Data + Num, Value);
+		return true;
+	});
+
+	return Total;
+}
+
+int64 UNumericBPLibrary::FileSearch(const FString& Path, const TArray<int32>& B, bool& found, bool& Success)
+{
+	int64 Index = -1;
+
+	// Each chunk is preceded by the last B.Num() - 1 elements of the previous one, so straddling matches are seen whole.
+	Success = FNumericFileStream(Path).ForEachChunk([&Index, &B](const int32* Data, int32 Num, int64 FirstIndex)
+	{
+		const int32* Result = std::search(Data, Data + Num, B.GetData(), B.GetData() + B.Num());
+		if (Result != Data + Num)
+		{
+			Index = FirstIndex + (Result - Data);
+			return false;
+		}
+		return true;
+	}, FMath::Max(B.Num() - 1, 0));
+
+	found = Index >= 0;
+	return Index;
+}
+
+bool UNumericBPLibrary::FileIsSorted(const FString& Path, bool& Success)
+{
+	bool bSorted = true;
+
+	// One element of overlap compares the last element of each chunk with the first of the next.
+	Success = FNumericFileStream(Path).ForEachChunk([&bSorted](const int32* Data, int32 Num, int64 FirstIndex)
+	{
+		bSorted = std::is_sorted(Data, Data + Num);
+		return bSorted;
+	}, 1);
+
+	return Success && bSorted;
+}
+
+bool UNumericBPLibrary::FilePartialSum(const FString& InPath, const FString& OutPath)
+{
+	TUniquePtr<IFileHandle> Out(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*OutPath));
+	if (!Out)
+	{
+		UE_LOGFMT(LogArrayUtils, Warning, "FilePartialSum: Could not open {0} for writing", OutPath);
+		return false;
+	}
+
+	TArray<int32> Sums;
+	int32 Carry = 0;
+	bool bWritten = true;
+
+	const bool bRead = FNumericFileStream(InPath).ForEachChunk([&Sums, &Carry, &bWritten, &Out](const int32* Data, int32 Num, int64 FirstIndex)
+	{
+		Sums.SetNumUninitialized(Num, EAllowShrinking::No);
+		std::partial_sum(Data, Data + Num, Sums.GetData());
+
+		// Offset the chunk by the running sum of everything before it.
+		for (int32& Sum : Sums)
+		{
+			Sum += Carry;
+		}
+		Carry = Sums.Last();
+
+		bWritten = Out->Write(reinterpret_cast<const uint8*>(Sums.GetData()), (int64)Num * sizeof(int32));
+		return bWritten;
+	});
+
+	return bRead && bWritten;
+}
+
+TArray<uint8> UNumericBPLibrary::CompactEncode(const TArray<int32>& A)
+{
+	TArray<uint8> Bytes;
+	FNumericCompactArray::Encode(A, Bytes);
+	return Bytes;
+}
+
+TArray<int32> UNumericBPLibrary::CompactDecode(const TArray<uint8>& Bytes, bool& Success)
+{
+	TArray<int32> Result;
+	Success = FNumericCompactArray::Decode(Bytes, Result);
+	return Result;
+}
+
+TArray<FNumericArrayHunk> UNumericBPLibrary::DiffArrays(const TArray<int32>& A, const TArray<int32>& B)
+{
+	return FNumericArrayDiff::Diff(A, B);
+}
+
+TArray<int32> UNumericBPLibrary::ApplyPatch(const TArray<int32>& A, const TArray<FNumericArrayHunk>& Hunks, bool& Success)
+{
+	TArray<int32> Result;
+	Success = FNumericArrayDiff::Apply(A, Hunks, Result);
+	return Result;
+}
+
+// Shared validation for the windowed functions. Returns the number of windows, or 0 if the arguments are invalid.
+static int32 NumWindows(const TCHAR* Function, int32 Num, int32 WindowSize, int32 Stride)
+{
+	if (WindowSize < 1 || Stride < 1 || WindowSize > Num)
+	{
+		UE_LOGFMT(LogArrayUtils, Warning, "{0}: Window must fit the array and stride must be positive. A.Num() = {1}, WindowSize = {2}, Stride = {3}", Function, Num, WindowSize, Stride);
+		return 0;
+	}
+	return (Num - WindowSize) / Stride + 1;
+}
+
+// Van Herk/Gil-Werman: split A into blocks of WindowSize and combine a suffix scan of one block with a prefix scan of the next,
+// so every window costs one operation regardless of its size.
+template <typename OpType>
+static TArray<int32> MovingExtreme(const TCHAR* Function, const TArray<int32>& A, int32 WindowSize, int32 Stride, OpType Op)
+{
+	TArray<int32> Result;
+	const int32 Windows = NumWindows(Function, A.Num(), WindowSize, Stride);
+	if (Windows == 0)
+	{
+		return Result;
+	}
+
+	const int32 Num = A.Num();
+	TArray<int32> Prefix;
+	TArray<int32> Suffix;
+	Prefix.SetNumUninitialized(Num);
+	Suffix.SetNumUninitialized(Num);
+
+	for (int32 i = 0; i < Num; ++i)
+	{
+		Prefix[i] = (i % WindowSize == 0) ? A[i] : Op(Prefix[i - 1], A[i]);
+	}
+	for (int32 i = Num - 1; i >= 0; --i)
+	{
+		Suffix[i] = (i == Num - 1 || i % WindowSize == WindowSize - 1) ? A[i] : Op(Suffix[i + 1], A[i]);
+	}
+
+	Result.SetNumUninitialized(Windows);
+	for (int32 w = 0; w < Windows; ++w)
+	{
+		const int32 Start = w * Stride;
+		Result[w] = Op(Suffix[Start], Prefix[Start + WindowSize - 1]);
+	}
+
+	return Result;
+}
+
+// 64-bit prefix sums with a leading zero, so the sum of A[i, j) is Prefix[j] - Prefix[i].
+static TArray<int64> PrefixSums64(const TArray<int32>& A)
+{
+	TArray<int64> Prefix;
+	Prefix.SetNumUninitialized(A.Num() + 1);
+	Prefix[0] = 0;
+	for (int32 i = 0; i < A.Num(); ++i)
+	{
+		Prefix[i + 1] = Prefix[i] + A[i];
+	}
+	return Prefix;
+}
+
+TArray<int32> UNumericBPLibrary::MovingSum(const TArray<int32>& A, int32 WindowSize, int32 Stride)
+{
+	TArray<int32> Result;
+	const int32 Windows = NumWindows(TEXT("MovingSum"), A.Num(), WindowSize, Stride);
+	if (Windows > 0)
+	{
+		const TArray<int64> Prefix = PrefixSums64(A);
+		Result.SetNumUninitialized(Windows);
+		for (int32 w = 0; w < Windows; ++w)
+		{
+			Result[w] = (int32)(Prefix[w * Stride + WindowSize] - Prefix[w * Stride]);
+		}
+	}
+	return Result;
+}
+
+TArray<double> UNumericBPLibrary::MovingMean(const TArray<int32>& A, int32 WindowSize, int32 Stride)
+{
+	TArray<double> Result;
+	const int32 Windows = NumWindows(TEXT("MovingMean"), A.Num(), WindowSize, Stride);
+	if (Windows > 0)
+	{
+		const TArray<int64> Prefix = PrefixSums64(A);
+		Result.SetNumUninitialized(Windows);
+		for (int32 w = 0; w < Windows; ++w)
+		{
+			Result[w] = (double)(Prefix[w * Stride + WindowSize] - Prefix[w * Stride]) / WindowSize;
+		}
+	}
+	return Result;
+}
+
+TArray<int32> UNumericBPLibrary::MovingMin(const TArray<int32>& A, int32 WindowSize, int32 Stride)
+{
+	return MovingExtreme(TEXT("MovingMin"), A, WindowSize, Stride, [](int32 X, int32 Y) { return FMath::Min(X, Y); });
+}
+
+TArray<int32> UNumericBPLibrary::MovingMax(const TArray<int32>& A, int32 WindowSize, int32 Stride)
+{
+	return MovingExtreme(TEXT("MovingMax"), A, WindowSize, Stride, [](int32 X, int32 Y) { return FMath::Max(X, Y); });
+}
+
+FNumericSlidingWindow UNumericBPLibrary::MakeSlidingWindow(int32 WindowSize)
+{
+	return FNumericSlidingWindow(WindowSize);
+}
+
+void UNumericBPLibrary::SlidingWindowPush(UPARAM(ref) FNumericSlidingWindow& Window, int32 Sample)
+{
+	Window.Push(Sample);
+}
+
+int32 UNumericBPLibrary::SlidingWindowStats(const FNumericSlidingWindow& Window, int64& Sum, int32& Min, int32& Max, double& Mean)
+{
+	Sum = Window.Sum();
+	Min = Window.Min();
+	Max = Window.Max();
+	Mean = Window.Mean();
+	return Window.Num();
+}
+
+TArray<int32> UNumericBPLibrary::ArgSort(const TArray<int32>& A)
+{
+	return FNumericSort::ArgSort(A);
+}
+
+bool UNumericBPLibrary::SortByKey(const TArray<int32>& Keys, const TArray<int32>& Values, TArray<int32>& SortedKeys, TArray<int32>& SortedValues)
+{
+	if (Keys.Num() != Values.Num())
+	{
+		UE_LOGFMT(LogArrayUtils, Warning, "SortByKey: Arrays must be of equal length. Keys.Num() = {0}, Values.Num() = {1}", Keys.Num(), Values.Num());
+		SortedKeys.Reset();
+		SortedValues.Reset();
+		return false;
+	}
+
+	SortedKeys = Keys;
+	SortedValues = Values;
+	FNumericSort::SortByKey(SortedKeys, SortedValues);
+	return true;
+}
+
+TArray<int32> UNumericBPLibrary::Gather(const TArray<int32>& A, const TArray<int32>& Indices, bool& Success)
+{
+	Success = Algo::NoneOf(Indices, [&A](int32 Index) { return !A.IsValidIndex(Index); });
+	if (!Success)
+	{
+		UE_LOGFMT(LogArrayUtils, Warning, "Gather: Every index must be within the array. A.Num() = {0}", A.Num());
+		return TArray<int32>();
+	}
+
+	return FNumericSort::Gather<int32>(A, Indices);
+}
+
+TArray<int32> UNumericBPLibrary::Scatter(const TArray<int32>& A, const TArray<int32>& Permutation, bool& Success)
+{
+	Success = A.Num() == Permutation.Num() && FNumericSort::IsPermutation(Permutation);
+	if (!Success)
+	{
+		UE_LOGFMT(LogArrayUtils, Warning, "Scatter: Permutation must hold each index of the array exactly once. A.Num() = {0}, Permutation.Num() = {1}", A.Num(), Permutation.Num());
+		return TArray<int32>();
+	}
+
+	return FNumericSort::Scatter<int32>(A, Permutation);
+}
+
+// Branchless binary search for the first element for which IsBefore is false. The range halves on every step
+// whatever the comparison gives, so there is no branch to mispredict, and both candidates of the next step are prefetched.
+template <typename PredicateType>
+static int32 PartitionPoint(TArrayView<const int32> A, PredicateType IsBefore)
+{
+	if (A.Num() == 0)
+	{
+		return 0;
+	}
+
+	const int32* Base = A.GetData();
+	int32 Len = A.Num();
+	while (Len > 1)
+	{
+		const int32 Half = Len / 2;
+		FPlatformMisc::Prefetch(Base + Half / 2);
+		FPlatformMisc::Prefetch(Base + Half + Half / 2);
+		Base += IsBefore(Base[Half - 1]) ? Half : 0;
+		Len -= Half;
+	}
+
+	return (int32)(Base - A.GetData()) + IsBefore(*Base);
+}
+
+int32 UNumericBPLibrary::LowerBound(const TArray<int32>& A, int32 Value)
+{
+	return PartitionPoint(A, [Value](int32 Element) { return Element < Value; });
+}
+
+int32 UNumericBPLibrary::UpperBound(const TArray<int32>& A, int32 Value)
+{
+	return PartitionPoint(A, [Value](int32 Element) { return Element <= Value; });
+}
+
+int32 UNumericBPLibrary::EqualRange(const TArray<int32>& A, int32 Value, int32& First, int32& Last)
+{
+	First = LowerBound(A, Value);
+	Last = UpperBound(A, Value);
+	return Last - First;
+}
+
+int32 UNumericBPLibrary::BinarySearch(const TArray<int32>& A, int32 Value, bool& found)
+{
+	const int32 Index = LowerBound(A, Value);
+	found = Index < A.Num() && A[Index] == Value;
+	return found ? Index : -1;
+}
+
+TArray<int32> UNumericBPLibrary::BatchLowerBound(const TArray<int32>& A, const TArray<int32>& Values)
+{
+	constexpr int32 BatchNum = 16;
+
+	TArray<int32> Result;
+	Result.SetNumUninitialized(Values.Num());
+
+	// Raw pointers keep the bounds checks of TArray::operator[] out of the lockstep loop.
+	const int32* Data = A.GetData();
+	const int32* Queries = Values.GetData();
+	int32* Out = Result.GetData();
+
+	// The sequence of range lengths depends only on A.Num(), so a batch of searches advances in lockstep
+	// and the loads of one search overlap with those of the others.
+	for (int32 Start = 0; Start < Values.Num(); Start += BatchNum)
+	{
+		const int32 Count = FMath::Min(BatchNum, Values.Num() - Start);
+		const int32* Batch = Queries + Start;
+		int32 Bases[BatchNum] = {};
+
+		int32 Len = A.Num();
+		while (Len > 1)
+		{
+			const int32 Half = Len / 2;
+			for (int32 j = 0; j < Count; ++j)
+			{
+				FPlatformMisc::Prefetch(Data + Bases[j] + Half / 2);
+				FPlatformMisc::Prefetch(Data + Bases[j] + Half + Half / 2);
+				Bases[j] += (Data[Bases[j] + Half - 1] < Batch[j]) ? Half : 0;
+			}
+			Len -= Half;
+		}
+
+		for (int32 j = 0; j < Count; ++j)
+		{
+			Out[Start + j] = Bases[j] + (A.Num() > 0 && Data[Bases[j]] < Batch[j]);
+		}
+	}
+
+	return Result;
+}
+
+FNumericSortedIndex UNumericBPLibrary::MakeSortedIndex(const TArray<int32>& A, bool& Success)
+{
+	Success = IsSorted(A);
+	if (!Success)
+	{
+		UE_LOGFMT(LogArrayUtils, Warning, "MakeSortedIndex: Array must be sorted in ascending order. A.Num() = {0}", A.Num());
+		return FNumericSortedIndex();
+	}
+
+	return FNumericSortedIndex(A);
+}
+
+int32 UNumericBPLibrary::SortedIndexLowerBound(const FNumericSortedIndex& Index, int32 Value)
+{
+	return Index.LowerBound(Value);
+}
+
+TArray<int32> UNumericBPLibrary::SortedIndexBatchLowerBound(const FNumericSortedIndex& Index, const TArray<int32>& Values)
+{
+	return Index.LowerBound(Values);
+}
+
+FNumericArrayHandle UNumericBPLibrary::MakeArrayHandle(const TArray<int32>& A)
+{
+	return FNumericArrayHandle(A);
+}
+
+TArray<int32> UNumericBPLibrary::ArrayHandleToArray(const FNumericArrayHandle& Handle)
+{
+	return Handle.ToArray();
+}
+
+int32 UNumericBPLibrary::ArrayHandleNum(const FNumericArrayHandle& Handle)
+{
+	return Handle.Num();
+}
+
+int32 UNumericBPLibrary::ArrayHandleGet(const FNumericArrayHandle& Handle, int32 Index, bool& IsValid)
+{
+	IsValid = Handle.IsValidIndex(Index);
+	return IsValid ? Handle.View()[Index] : 0;
+}
+
+bool UNumericBPLibrary::ArrayHandleSet(UPARAM(ref) FNumericArrayHandle& Handle, int32 Index, int32 Value)
+{
+	if (!Handle.IsValidIndex(Index))
+	{
+		UE_LOGFMT(LogArrayUtils, Warning, "ArrayHandleSet: Index out of range. Index = {0}, Handle.Num() = {1}", Index, Handle.Num());
+		return false;
+	}
+
+	Handle.Mutate()[Index] = Value;
+	return true;
+}
+
+FNumericArrayHandle UNumericBPLibrary::ArrayHandleTake(const FNumericArrayHandle& Handle, int32 N)
+{
+	return Handle.Slice(0, N);
+}
+
+FNumericArrayHandle UNumericBPLibrary::ArrayHandleSlice(const FNumericArrayHandle& Handle, int32 Start, int32 Count)
+{
+	return Handle.Slice(Start, Count);
+}
+
+int32 UNumericBPLibrary::ArrayHandleMax(const FNumericArrayHandle& Handle)
+{
+	const TArrayView<const int32> A = Handle.View();
+	return A.Num() > 0 ? *std::max_element(A.GetData(), A.GetData() + A.Num()) : -1;
+}
+
+int32 UNumericBPLibrary::ArrayHandleMin(const FNumericArrayHandle& Handle)
+{
+	const TArrayView<const int32> A = Handle.View();
+	return A.Num() > 0 ? *std::min_element(A.GetData(), A.GetData() + A.Num()) : -1;
+}
+
+int32 UNumericBPLibrary::ArrayHandleAccumulate(const FNumericArrayHandle& Handle)
+{
+	const TArrayView<const int32> A = Handle.View();
+	return A.Num() > 0 ? std::accumulate(A.GetData(), A.GetData() + A.Num(), 0) : -1;
+}
+
+int32 UNumericBPLibrary::ArrayHandleCount(const FNumericArrayHandle& Handle, int32 Value)
+{
+	const TArrayView<const int32> A = Handle.View();
+	return A.Num() > 0 ? std::count(A.GetData(), A.GetData() + A.Num(), Value) : -1;
+}
+
+FNumericArrayHandle UNumericBPLibrary::BiggestArrayHandle(const FNumericArrayHandle& A, const FNumericArrayHandle& B)
+{
+	const int32 SumA = std::accumulate(A.View().GetData(), A.View().GetData() + A.Num(), 0);
+	const int32 SumB = std::accumulate(B.View().GetData(), B.View().GetData() + B.Num(), 0);
+
+	return (SumA > SumB) ? A : B;
+}
+
+FNumericArrayHandle UNumericBPLibrary::SmallestArrayHandle(const FNumericArrayHandle& A, const FNumericArrayHandle& B)
+{
+	const int32 SumA = std::accumulate(A.View().GetData(), A.View().GetData() + A.Num(), 0);
+	const int32 SumB = std::accumulate(B.View().GetData(), B.View().GetData() + B.Num(), 0);
+
+	return (SumA > SumB) ? B : A;
+}
+
+void UNumericBPLibrary::ArrayHandleMinMax(const FNumericArrayHandle& Handle, int32& Min, int32& Max)
+{
+	const TArrayView<const int32> A = Handle.View();
+	if (A.Num() > 0)
+	{
+		const std::pair<const int32*, const int32*> MinMax = std::minmax_element(A.GetData(), A.GetData() + A.Num());
+		Min = *MinMax.first;
+		Max = *MinMax.second;
+	}
+	else
+	{
+		UE_LOGFMT(LogArrayUtils, Warning, "ArrayHandleMinMax: Handle must have at least 1 elements. Handle.Num() = {0}", Handle.Num());
+		Min = 0;
+		Max = 0;
+	}
+}
+
+bool UNumericBPLibrary::ArrayHandleIsSorted(const FNumericArrayHandle& Handle)
+{
+	const TArrayView<const int32> A = Handle.View();
+	return std::is_sorted(A.GetData(), A.GetData() + A.Num());
+}
+
+bool UNumericBPLibrary::ArrayHandleIsEqual(const FNumericArrayHandle& A, const FNumericArrayHandle& B)
+{
+	const TArrayView<const int32> ViewA = A.View();
+	const TArrayView<const int32> ViewB = B.View();
+	return ViewA.Num() == ViewB.Num() && (ViewA.GetData() == ViewB.GetData() || std::equal(ViewA.GetData(), ViewA.GetData() + ViewA.Num(), ViewB.GetData()));
+}
+
+int64 UNumericBPLibrary::ArrayHandleInnerProduct(const FNumericArrayHandle& A, const FNumericArrayHandle& B, bool& Success)
+{
+	Success = A.Num() == B.Num();
+	if (!Success)
+	{
+		UE_LOGFMT(LogArrayUtils, Warning, "ArrayHandleInnerProduct: Handles must be of equal length. A.Num() = {0}, B.Num() = {1}", A.Num(), B.Num());
+		return 0;
+	}
+
+	return FNumericMatrix::Dot(A.View().GetData(), B.View().GetData(), A.Num());
+}
+
+int32 UNumericBPLibrary::ArrayHandleLowerBound(const FNumericArrayHandle& Handle, int32 Value)
+{
+	return PartitionPoint(Handle.View(), [Value](int32 Element) { return Element < Value; });
+}
+
+int32 UNumericBPLibrary::ArrayHandleBinarySearch(const FNumericArrayHandle& Handle, int32 Value, bool& found)
+{
+	const int32 Index = ArrayHandleLowerBound(Handle, Value);
+	found = Index < Handle.Num() && Handle.View()[Index] == Value;
+	return found ? Index : -1;
+}
+
+void UNumericBPLibrary::ArrayHandleSort(UPARAM(ref) FNumericArrayHandle& Handle, bool bDescending)
+{
+	FNumericSort::Sort(Handle.Mutate(), bDescending);
+}
+
+void UNumericBPLibrary::ArrayHandleFill(UPARAM(ref) FNumericArrayHandle& Handle, int32 Value)
+{
+	const TArrayView<int32> A = Handle.Overwrite();
+	FNumericTransform::Generate(A.GetData(), A.Num(), [Value](int32 i) { return Value; });
+}
+
+int32 UNumericBPLibrary::ArrayHandleReplace(UPARAM(ref) FNumericArrayHandle& Handle, int32 OldValue, int32 NewValue)
+{
+	// Only a handle that actually changes gets storage of its own.
+	const TArrayView<const int32> View = Handle.View();
+	const int32 First = std::find(View.GetData(), View.GetData() + View.Num(), OldValue) - View.GetData();
+	if (First == View.Num() || OldValue == NewValue)
+	{
+		return std::count(View.GetData() + First, View.GetData() + View.Num(), OldValue);
+	}
+
+	const TArrayView<int32> A = Handle.Mutate();
+	int32 Replaced = 0;
+	for (int32 i = First; i < A.Num(); ++i)
+	{
+		Replaced += A[i] == OldValue;
+		A[i] = A[i] == OldValue ? NewValue : A[i];
+	}
+	return Replaced;
+}
+
+void UNumericBPLibrary::ArrayHandleClamp(UPARAM(ref) FNumericArrayHandle& Handle, int32 Min, int32 Max)
+{
+	const TArrayView<int32> A = Handle.Mutate();
+	int32* Data = A.GetData();
+	FNumericTransform::Generate(Data, A.Num(), [Data, Min, Max](int32 i) { return FMath::Clamp(Data[i], Min, Max); });
+}
+
+void UNumericBPLibrary::ArrayHandleRotate(UPARAM(ref) FNumericArrayHandle& Handle, int32 Amount)
+{
+	if (Handle.Num() == 0)
+	{
+		UE_LOGFMT(LogArrayUtils, Warning, "ArrayHandleRotate: Handle must have at least 1 elements. Handle.Num() = {0}", Handle.Num());
+		return;
+	}
+
+	Amount = Amount % Handle.Num();
+	Amount = (Amount < 0) ? Handle.Num() + Amount : Amount;
+	if (Amount != 0)
+	{
+		const TArrayView<int32> A = Handle.Mutate();
+		std::rotate(A.GetData(), A.GetData() + Amount, A.GetData() + A.Num());
+	}
+}
+
+TArray<int32> UNumericBPLibrary::Unique(const TArray<int32>& A)
+{
+	TArray<int32> Result;
+	Result.SetNumUninitialized(A.Num());
+
+	// Branchless compaction: every element is written, but the cursor only advances past a new value.
+	int32 Kept = FMath::Min(A.Num(), 1);
+	if (Kept > 0)
+	{
+		Result[0] = A[0];
+	}
+	for (int32 i = 1; i < A.Num(); ++i)
+	{
+		Result[Kept] = A[i];
+		Kept += A[i] != A[i - 1];
+	}
+
+	Result.SetNum(Kept);
+	return Result;
+}
+
+void UNumericBPLibrary::RunLengthEncode(const TArray<int32>& A, TArray<int32>& Values, TArray<int32>& Counts)
+{
+	Values.Reset();
+	Counts.Reset();
+
+	int32 RunStart = 0;
+	for (int32 i = 1; i <= A.Num(); ++i)
+	{
+		if (i == A.Num() || A[i] != A[i - 1])
+		{
+			Values.Add(A[i - 1]);
+			Counts.Add(i - RunStart);
+			RunStart = i;
+		}
+	}
+}
+
+// Value ranges up to this many buckets are counted per worker thread and merged; wider ones are counted on one thread.
+static constexpr int64 MaxParallelDenseRange = 64 * 1024;
+
+// Value ranges up to this many buckets per element are counted in a flat array rather than a hash map.
+static constexpr int64 MaxDenseRangePerElement = 2;
+
+// Upper bound on the buckets of all dense histograms together (256 MB of counters); past it the sparse path is used.
+static constexpr int64 MaxDenseBuckets = 64 * 1024 * 1024;
+
+void UNumericBPLibrary::CountByValue(const TArray<int32>& A, TArray<int32>& Values, TArray<int32>& Counts)
+{
+	Values.Reset();
+	Counts.Reset();
+
+	if (A.Num() == 0)
+	{
+		return;
+	}
+
+	int32 Min, Max;
+	ArrayMinMax(A, Min, Max);
+	const int64 Range = (int64)Max - Min + 1;
+	const int32 NumChunks = FNumericSort::NumParallelChunks(A.Num());
+
+	auto ChunkBegin = [&A, NumChunks](int32 Chunk) { return (int32)((int64)A.Num() * Chunk / NumChunks); };
+
+	// Dense path: the values span a small range, so count into a flat array indexed by value.
+	const int32 NumHistograms = Range <= MaxParallelDenseRange ? NumChunks : 1;
+	const int64 NumBuckets = NumHistograms * Range;
+	if (Range <= FMath::Max<int64>(MaxDenseRangePerElement * A.Num(), 1024) && NumBuckets <= MaxDenseBuckets)
+	{
+		TArray<int32> Histograms;
+		Histograms.SetNumZeroed((int32)NumBuckets);
+
+		ParallelFor(NumHistograms, [&](int32 Chunk)
+		{
+			int32* Histogram = Histograms.GetData() + Chunk * Range;
+			const int32 End = NumHistograms == 1 ? A.Num() : ChunkBegin(Chunk + 1);
+			for (int32 i = NumHistograms == 1 ? 0 : ChunkBegin(Chunk); i < End; ++i)
+			{
+				++Histogram[A[i] - Min];
+			}
+		}, NumHistograms == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+		for (int32 Bucket = 0; Bucket < Range; ++Bucket)
+		{
+			int32 Total = 0;
+			for (int32 Chunk = 0; Chunk < NumHistograms; ++Chunk)
+			{
+				Total += Histograms[Chunk * Range + Bucket];
+			}
+
+			if (Total > 0)
+			{
+				Values.Add(Min + Bucket);
+				Counts.Add(Total);
+			}
+		}
+		return;
+	}
+
+	// Sparse path: count per chunk into hash maps, then merge them.
+	TArray<TMap<int32, int32>> Partials;
+	Partials.SetNum(NumChunks);
+
+	ParallelFor(NumChunks, [&](int32 Chunk)
+	{
+		TMap<int32, int32>& Partial = Partials[Chunk];
+		for (int32 i = ChunkBegin(Chunk); i < ChunkBegin(Chunk + 1); ++i)
+		{
+			++Partial.FindOrAdd(A[i]);
+		}
+	}, NumChunks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	TMap<int32, int32>& Merged = Partials[0];
+	for (int32 Chunk = 1; Chunk < NumChunks; ++Chunk)
+	{
+		for (const TPair<int32, int32>& Pair : Partials[Chunk])
+		{
+			Merged.FindOrAdd(Pair.Key) += Pair.Value;
+		}
+	}
+
+	Merged.KeySort(TLess<int32>());
+	Values.Reserve(Merged.Num());
+	Counts.Reserve(Merged.Num());
+	for (const TPair<int32, int32>& Pair : Merged)
+	{
+		Values.Add(Pair.Key);
+		Counts.Add(Pair.Value);
+	}
+}
+
+FNumericMask UNumericBPLibrary::MaskEqual(const TArray<int32>& A, int32 Value)
+{
+	return FNumericMask::FromPredicate(A, [Value](int32 Element) { return Element == Value; });
+}
+
+FNumericMask UNumericBPLibrary::MaskGreater(const TArray<int32>& A, int32 Value)
+{
+	return FNumericMask::FromPredicate(A, [Value](int32 Element) { return Element > Value; });
+}
+
+FNumericMask UNumericBPLibrary::MaskLess(const TArray<int32>& A, int32 Value)
+{
+	return FNumericMask::FromPredicate(A, [Value](int32 Element) { return Element < Value; });
+}
+
+FNumericMask UNumericBPLibrary::MaskInRange(const TArray<int32>& A, int32 Min, int32 Max)
+{
+	if (Min > Max)
+	{
+		return FNumericMask(A.Num());
+	}
+
+	// One unsigned compare tests both bounds.
+	const uint32 Width = (uint32)Max - (uint32)Min;
+	return FNumericMask::FromPredicate(A, [Min, Width](int32 Element) { return (uint32)Element - (uint32)Min <= Width; });
+}
+
+FNumericMask UNumericBPLibrary::MaskAnd(const FNumericMask& A, const FNumericMask& B, bool& Success)
+{
+	Success = A.Num() == B.Num();
+	if (!Success)
+	{
+		UE_LOGFMT(LogArrayUtils, Warning, "MaskAnd: Masks must be of equal length. A.Num() = {0}, B.Num() = {1}", A.Num(), B.Num());
+		return FNumericMask();
+	}
+	return A & B;
+}
+
+FNumericMask UNumericBPLibrary::MaskOr(const FNumericMask& A, const FNumericMask& B, bool& Success)
+{
+	Success = A.Num() == B.Num();
+	if (!Success)
+	{
+		UE_LOGFMT(LogArrayUtils, Warning, "MaskOr: Masks must be of equal length. A.Num() = {0}, B.Num() = {1}", A.Num(), B.Num());
+		return FNumericMask();
+	}
+	return A | B;
+}
+
+FNumericMask UNumericBPLibrary::MaskNot(const FNumericMask& A)
+{
+	return ~A;
+}
+
+int32 UNumericBPLibrary::MaskCount(const FNumericMask& A)
+{
+	return A.CountSetBits();
+}
+
+TArray<int32> UNumericBPLibrary::MaskSelect(const TArray<int32>& A, const FNumericMask& Mask, bool& Success)
+{
+	Success = A.Num() == Mask.Num();
+	if (!Success)
+	{
+		UE_LOGFMT(LogArrayUtils, Warning, "MaskSelect: The mask must have one bit per element. A.Num() = {0}, Mask.Num() = {1}", A.Num(), Mask.Num());
+		return TArray<int32>();
+	}
+	return Mask.Select(A);
+}
+
+TArray<int32> UNumericBPLibrary::MaskIndices(const FNumericMask& A)
+{
+	return A.Indices();
+}
+
+TArray<int64> UNumericBPLibrary::InnerProductBatch(const TArray<int32>& Query, const TArray<int32>& Matrix, bool& Success)
+{
+	Success = Query.Num() > 0 && Matrix.Num() % Query.Num() == 0;
+	if (!Success)
+	{
+		UE_LOGFMT(LogArrayUtils, Warning, "InnerProductBatch: Matrix must hold a whole number of rows of the query's length. Query.Num() = {0}, Matrix.Num() = {1}", Query.Num(), Matrix.Num());
+		return TArray<int64>();
+	}
+
+	TArray<int64> Result;
+	Result.SetNumUninitialized(Matrix.Num() / Query.Num());
+	FNumericMatrix::MatrixVector(Matrix, Result.Num(), Query, Result.GetData());
+	return Result;
+}
+
+TArray<int64> UNumericBPLibrary::MatrixVectorMultiply(const TArray<int32>& Matrix, int32 NumRows, const TArray<int32>& Vector, bool& Success)
+{
+	Success = NumRows >= 0 && (int64)NumRows * Vector.Num() == Matrix.Num();
+	if (!Success)
+	{
+		UE_LOGFMT(LogArrayUtils, Warning, "MatrixVectorMultiply: Matrix must have NumRows * Vector.Num() elements. NumRows = {0}, Vector.Num() = {1}, Matrix.Num() = {2}", NumRows, Vector.Num(), Matrix.Num());
+		return TArray<int64>();
+	}
+
+	TArray<int64> Result;
+	Result.SetNumUninitialized(NumRows);
+	FNumericMatrix::MatrixVector(Matrix, NumRows, Vector, Result.GetData());
+	return Result;
+}
+
+TArray<int64> UNumericBPLibrary::MatrixMultiply(const TArray<int32>& A, const TArray<int32>& B, int32 M, int32 K, int32 N, bool& Success)
+{
+	Success = M > 0 && K > 0 && N > 0 && (int64)M * K == A.Num() && (int64)K * N == B.Num() && (int64)M * N <= MAX_int32;
+	if (!Success)
+	{
+		UE_LOGFMT(LogArrayUtils, Warning, "MatrixMultiply: Dimensions must be positive and match the matrices. M = {0}, K = {1}, N = {2}, A.Num() = {3}, B.Num() = {4}", M, K, N, A.Num(), B.Num());
+		return TArray<int64>();
+	}
+
+	TArray<int64> Result;
+	Result.SetNumUninitialized(M * N);
+	FNumericMatrix::MatrixMultiply(A, B, M, K, N, Result.GetData());
+	return Result;
 }
\ No newline at end of file
@@ -0,0 +1,545 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#include "NumericCompactArray.h"
+#include "NumericBPLibrary.h"
+#include "Logging/StructuredLog.h"
+#include <algorithm>
+
+#if PLATFORM_CPU_X86_FAMILY
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	uint32 ZigZag(int32 Value)
+	{
+		return ((uint32)Value << 1) ^ (uint32)(Value >> 31);
+	}
+
+	int32 UnZigZag(uint32 Value)
+	{
+		return (int32)((Value >> 1) ^ (0u - (Value & 1)));
+	}
+
+	int32 VarintSize(uint32 Value)
+	{
+		// Each byte holds 7 bits of payload.
+		return 1 + (Value >= (1u << 7)) + (Value >= (1u << 14)) + (Value >= (1u << 21)) + (Value >= (1u << 28));
+	}
+
+	int32 BitWidth(uint32 Value)
+	{
+		return 32 - (int32)FPlatformMath::CountLeadingZeros(Value);
+	}
+
+	uint8* WriteVarint(uint8* Out, uint32 Value)
+	{
+		while (Value >= 0x80)
+		{
+			*Out++ = (uint8)(Value | 0x80);
+			Value >>= 7;
+		}
+		*Out++ = (uint8)Value;
+		return Out;
+	}
+
+	void WriteVarint(TArray<uint8>& Out, uint32 Value)
+	{
+		const int32 First = Out.Num();
+		Out.AddUninitialized(VarintSize(Value));
+		WriteVarint(Out.GetData() + First, Value);
+	}
+
+	/** Number of lanes of BitPackedLanes blocks, one per 32-bit element of an SSE2 register. */
+	constexpr int32 NumLanes = 4;
+
+	/**
+	 * Packs a full block of offsets from Min, Bits wide, in the BitPackedLanes layout: element i goes to lane i % 4, each
+	 * lane is a little-endian bit stream least significant bit first, and word w of lane l is stored at word w * 4 + l.
+	 * Writes Bits * 16 bytes.
+	 */
+	void PackLanes(const int32* Data, uint32 Min, int32 Bits, uint8* Out)
+	{
+		constexpr int32 NumSteps = FNumericCompactArray::BlockNum / NumLanes;
+
+#if PLATFORM_CPU_X86_FAMILY && PLATFORM_LITTLE_ENDIAN
+		// Every lane consumes the same number of bits per step, so all shifts are shared by the four lanes.
+		const __m128i Base = _mm_set1_epi32((int32)Min);
+		__m128i* Dest = reinterpret_cast<__m128i*>(Out);
+		__m128i Pending = _mm_setzero_si128();
+		int32 NumPending = 0;
+		for (int32 Step = 0; Step < NumSteps; ++Step)
+		{
+			const __m128i Value = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + Step * NumLanes)), Base);
+			Pending = _mm_or_si128(Pending, _mm_sll_epi32(Value, _mm_cvtsi32_si128(NumPending)));
+			NumPending += Bits;
+			if (NumPending >= 32)
+			{
+				_mm_storeu_si128(Dest++, Pending);
+				NumPending -= 32;
+
+				// The bits of Value that did not fit start the next word. Shifts by 32 give 0.
+				Pending = _mm_srl_epi32(Value, _mm_cvtsi32_si128(Bits - NumPending));
+			}
+		}
+#else
+		for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+		{
+			uint8* Word = Out + Lane * sizeof(uint32);
+			uint64 Pending = 0;
+			int32 NumPending = 0;
+			for (int32 Step = 0; Step < NumSteps; ++Step)
+			{
+				Pending |= (uint64)((uint32)Data[Step * NumLanes + Lane] - Min) << NumPending;
+				NumPending += Bits;
+				if (NumPending >= 32)
+				{
+					Word[0] = (uint8)Pending;
+					Word[1] = (uint8)(Pending >> 8);
+					Word[2] = (uint8)(Pending >> 16);
+					Word[3] = (uint8)(Pending >> 24);
+					Word += NumLanes * sizeof(uint32);
+					Pending >>= 32;
+					NumPending -= 32;
+				}
+			}
+		}
+#endif
+	}
+
+	/** Inverse of PackLanes: reads Bits * 16 bytes and writes a full block. */
+	void UnpackLanes(const uint8* In, uint32 Min, int32 Bits, int32* Dest)
+	{
+		constexpr int32 NumSteps = FNumericCompactArray::BlockNum / NumLanes;
+
+#if PLATFORM_CPU_X86_FAMILY && PLATFORM_LITTLE_ENDIAN
+		const __m128i Base = _mm_set1_epi32((int32)Min);
+		const __m128i Mask = _mm_set1_epi32((int32)(uint32)((1ull << Bits) - 1));
+		const __m128i* Source = reinterpret_cast<const __m128i*>(In);
+		__m128i Word = _mm_setzero_si128();
+		int32 NumLeft = 0;
+		for (int32 Step = 0; Step < NumSteps; ++Step)
+		{
+			// The NumLeft unread bits sit at the top of Word; a value that straddles two words takes the rest from the next.
+			__m128i Value = _mm_srl_epi32(Word, _mm_cvtsi32_si128(32 - NumLeft));
+			if (NumLeft < Bits)
+			{
+				Word = _mm_loadu_si128(Source++);
+				Value = _mm_or_si128(Value, _mm_sll_epi32(Word, _mm_cvtsi32_si128(NumLeft)));
+				NumLeft += 32;
+			}
+			NumLeft -= Bits;
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Dest + Step * NumLanes), _mm_add_epi32(_mm_and_si128(Value, Mask), Base));
+		}
+#else
+		const uint64 Mask = (1ull << Bits) - 1;
+		for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+		{
+			const uint8* Word = In + Lane * sizeof(uint32);
+			uint64 Pending = 0;
+			int32 NumPending = 0;
+			for (int32 Step = 0; Step < NumSteps; ++Step)
+			{
+				if (NumPending < Bits)
+				{
+					Pending |= (uint64)((uint32)Word[0] | ((uint32)Word[1] << 8) | ((uint32)Word[2] << 16) | ((uint32)Word[3] << 24)) << NumPending;
+					Word += NumLanes * sizeof(uint32);
+					NumPending += 32;
+				}
+				Dest[Step * NumLanes + Lane] = (int32)(Min + (uint32)(Pending & Mask));
+				Pending >>= Bits;
+				NumPending -= Bits;
+			}
+		}
+#endif
+	}
+
+	/** Bounds-checked cursor over an encoded buffer. Any out-of-range read clears bOk. */
+	struct FReader
+	{
+		const uint8* Cursor;
+		const uint8* End;
+		bool bOk = true;
+
+		uint8 ReadByte()
+		{
+			if (Cursor >= End)
+			{
+				bOk = false;
+				return 0;
+			}
+			return *Cursor++;
+		}
+
+		uint32 ReadVarint()
+		{
+			// A varint is at most five bytes, so away from the end of the buffer no read needs checking.
+			if (End - Cursor >= 5)
+			{
+				uint32 Value = 0;
+				for (int32 Shift = 0; Shift < 35; Shift += 7)
+				{
+					const uint8 Byte = *Cursor++;
+					Value |= (uint32)(Byte & 0x7F) << Shift;
+					if (!(Byte & 0x80))
+					{
+						return Value;
+					}
+				}
+				bOk = false;
+				return 0;
+			}
+
+			uint32 Value = 0;
+			for (int32 Shift = 0; Shift < 35; Shift += 7)
+			{
+				const uint8 Byte = ReadByte();
+				Value |= (uint32)(Byte & 0x7F) << Shift;
+				if (!(Byte & 0x80))
+				{
+					return Value;
+				}
+			}
+			bOk = false;
+			return 0;
+		}
+
+		const uint8* ReadBytes(int64 Num)
+		{
+			if (End - Cursor < Num)
+			{
+				bOk = false;
+				return nullptr;
+			}
+			const uint8* Bytes = Cursor;
+			Cursor += Num;
+			return Bytes;
+		}
+	};
+
+	void EncodeBlock(const int32* Data, int32 Num, TArray<uint8>& Out)
+	{
+		using EEncoding = FNumericCompactArray::EEncoding;
+
+		// Measure every encoding. This pass has no data-dependent branch, so it vectorizes.
+		int32 VarintBytes = VarintSize(ZigZag(Data[0]));
+		int32 DeltaBytes = VarintBytes;
+		int32 NumRuns = 1;
+		int32 RunValueBytes = VarintSize(ZigZag(Data[Num - 1]));
+		int32 Min = Data[0];
+		int32 Max = Data[0];
+		for (int32 i = 1; i < Num; ++i)
+		{
+			const bool bRunEnd = Data[i] != Data[i - 1];
+			VarintBytes += VarintSize(ZigZag(Data[i]));
+			DeltaBytes += VarintSize(ZigZag((int32)((uint32)Data[i] - (uint32)Data[i - 1])));
+			NumRuns += bRunEnd;
+			RunValueBytes += bRunEnd ? VarintSize(ZigZag(Data[i - 1])) : 0;
+			Min = FMath::Min(Min, Data[i]);
+			Max = FMath::Max(Max, Data[i]);
+		}
+
+		const int32 Bits = BitWidth((uint32)Max - (uint32)Min);
+		const int64 PackedBytes = VarintSize(ZigZag(Min)) + 1 + ((int64)Num * Bits + 7) / 8;
+		const int64 RawBytes = (int64)Num * sizeof(int32);
+
+		// Each run takes its value plus at least one byte of length, so runs are only sized exactly when run-length encoding can still win.
+		int64 RunBytes = MAX_int64;
+		if (RunValueBytes + NumRuns <= FMath::Min(FMath::Min<int64>(RawBytes, PackedBytes), FMath::Min<int64>(VarintBytes, DeltaBytes)))
+		{
+			RunBytes = 0;
+			for (int32 i = 0, RunStart = 0; i < Num; ++i)
+			{
+				if (i + 1 == Num || Data[i + 1] != Data[i])
+				{
+					RunBytes += VarintSize(ZigZag(Data[i])) + VarintSize(i + 1 - RunStart);
+					RunStart = i + 1;
+				}
+			}
+		}
+
+		EEncoding Encoding = EEncoding::Raw;
+		int64 Best = RawBytes;
+		auto Consider = [&Encoding, &Best](EEncoding Candidate, int64 Bytes)
+		{
+			if (Bytes < Best)
+			{
+				Encoding = Candidate;
+				Best = Bytes;
+			}
+		};
+		Consider(EEncoding::Varint, VarintBytes);
+		Consider(EEncoding::Delta, DeltaBytes);
+		Consider(EEncoding::RunLength, RunBytes);
+		Consider(Num == FNumericCompactArray::BlockNum ? EEncoding::BitPackedLanes : EEncoding::BitPacked, PackedBytes);
+
+		// Best is the exact encoded size, so the block is written through a raw pointer into space reserved up front.
+		const int32 First = Out.Num();
+		Out.AddUninitialized(1 + (int32)Best);
+		uint8* Cursor = Out.GetData() + First;
+		*Cursor++ = (uint8)Encoding;
+
+		switch (Encoding)
+		{
+		case EEncoding::Raw:
+			// Little-endian like every other encoding, so buffers move between platforms.
+#if PLATFORM_LITTLE_ENDIAN
+			FMemory::Memcpy(Cursor, Data, RawBytes);
+			Cursor += RawBytes;
+#else
+			for (int32 i = 0; i < Num; ++i)
+			{
+				Cursor[0] = (uint8)Data[i];
+				Cursor[1] = (uint8)(Data[i] >> 8);
+				Cursor[2] = (uint8)(Data[i] >> 16);
+				Cursor[3] = (uint8)(Data[i] >> 24);
+				Cursor += 4;
+			}
+#endif
+			break;
+
+		case EEncoding::Varint:
+			for (int32 i = 0; i < Num; ++i)
+			{
+				Cursor = WriteVarint(Cursor, ZigZag(Data[i]));
+			}
+			break;
+
+		case EEncoding::Delta:
+			Cursor = WriteVarint(Cursor, ZigZag(Data[0]));
+			for (int32 i = 1; i < Num; ++i)
+			{
+				Cursor = WriteVarint(Cursor, ZigZag((int32)((uint32)Data[i] - (uint32)Data[i - 1])));
+			}
+			break;
+
+		case EEncoding::RunLength:
+			for (int32 i = 0, RunStart = 0; i < Num; ++i)
+			{
+				if (i + 1 == Num || Data[i + 1] != Data[i])
+				{
+					Cursor = WriteVarint(Cursor, ZigZag(Data[i]));
+					Cursor = WriteVarint(Cursor, i + 1 - RunStart);
+					RunStart = i + 1;
+				}
+			}
+			break;
+
+		case EEncoding::BitPacked:
+		{
+			Cursor = WriteVarint(Cursor, ZigZag(Min));
+			*Cursor++ = (uint8)Bits;
+
+			// Values are appended least significant bit first to a 64-bit accumulator, which is flushed 32 bits at a time.
+			// Fewer than 32 bits are ever pending, so a 32-bit value always fits.
+			uint64 Pending = 0;
+			int32 NumPending = 0;
+			for (int32 i = 0; i < Num; ++i)
+			{
+				Pending |= (uint64)((uint32)Data[i] - (uint32)Min) << NumPending;
+				NumPending += Bits;
+				if (NumPending >= 32)
+				{
+					Cursor[0] = (uint8)Pending;
+					Cursor[1] = (uint8)(Pending >> 8);
+					Cursor[2] = (uint8)(Pending >> 16);
+					Cursor[3] = (uint8)(Pending >> 24);
+					Cursor += 4;
+					Pending >>= 32;
+					NumPending -= 32;
+				}
+			}
+			for (; NumPending > 0; NumPending -= 8)
+			{
+				*Cursor++ = (uint8)Pending;
+				Pending >>= 8;
+			}
+			break;
+		}
+
+		case EEncoding::BitPackedLanes:
+			Cursor = WriteVarint(Cursor, ZigZag(Min));
+			*Cursor++ = (uint8)Bits;
+			PackLanes(Data, (uint32)Min, Bits, Cursor);
+			Cursor += Bits * (FNumericCompactArray::BlockNum / 8);
+			break;
+		}
+
+		check(Cursor == Out.GetData() + Out.Num());
+	}
+
+	bool DecodeBlock(FReader& Reader, int32* Dest, int32 Num)
+	{
+		using EEncoding = FNumericCompactArray::EEncoding;
+
+		switch ((EEncoding)Reader.ReadByte())
+		{
+		case EEncoding::Raw:
+			if (const uint8* Bytes = Reader.ReadBytes((int64)Num * sizeof(int32)))
+			{
+#if PLATFORM_LITTLE_ENDIAN
+				FMemory::Memcpy(Dest, Bytes, Num * sizeof(int32));
+#else
+				for (int32 i = 0; i < Num; ++i, Bytes += 4)
+				{
+					Dest[i] = (int32)((uint32)Bytes[0] | ((uint32)Bytes[1] << 8) | ((uint32)Bytes[2] << 16) | ((uint32)Bytes[3] << 24));
+				}
+#endif
+			}
+			break;
+
+		case EEncoding::Varint:
+			for (int32 i = 0; i < Num; ++i)
+			{
+				Dest[i] = UnZigZag(Reader.ReadVarint());
+			}
+			break;
+
+		case EEncoding::Delta:
+			Dest[0] = UnZigZag(Reader.ReadVarint());
+			for (int32 i = 1; i < Num; ++i)
+			{
+				Dest[i] = (int32)((uint32)Dest[i - 1] + (uint32)UnZigZag(Reader.ReadVarint()));
+			}
+			break;
+
+		case EEncoding::RunLength:
+			for (int32 i = 0; i < Num && Reader.bOk;)
+			{
+				const int32 Value = UnZigZag(Reader.ReadVarint());
+				const uint32 Run = Reader.ReadVarint();
+				if (Run == 0 || Run > (uint32)(Num - i))
+				{
+					return false;
+				}
+				std::fill_n(Dest + i, Run, Value);
+				i += Run;
+			}
+			break;
+
+		case EEncoding::BitPacked:
+		{
+			const uint32 Min = (uint32)UnZigZag(Reader.ReadVarint());
+			const int32 Bits = Reader.ReadByte();
+			if (Bits > 32)
+			{
+				return false;
+			}
+
+			const uint8* Packed = Reader.ReadBytes(((int64)Num * Bits + 7) / 8);
+			if (!Packed)
+			{
+				return false;
+			}
+
+			// Refill a 64-bit accumulator 32 bits at a time, mirroring the encoder; the last word may be partial.
+			const uint8* PackedEnd = Packed + ((int64)Num * Bits + 7) / 8;
+			const uint64 Mask = (1ull << Bits) - 1;
+			uint64 Pending = 0;
+			int32 NumPending = 0;
+			for (int32 i = 0; i < Num; ++i)
+			{
+				if (NumPending < Bits)
+				{
+					uint64 Word = 0;
+					for (int32 Byte = 0; Byte < 4 && Packed < PackedEnd; ++Byte)
+					{
+						Word |= (uint64)*Packed++ << (Byte * 8);
+					}
+					Pending |= Word << NumPending;
+					NumPending += 32;
+				}
+				Dest[i] = (int32)(Min + (uint32)(Pending & Mask));
+				Pending >>= Bits;
+				NumPending -= Bits;
+			}
+			break;
+		}
+
+		case EEncoding::BitPackedLanes:
+		{
+			const uint32 Min = (uint32)UnZigZag(Reader.ReadVarint());
+			const int32 Bits = Reader.ReadByte();
+			if (Num != FNumericCompactArray::BlockNum || Bits > 32)
+			{
+				return false;
+			}
+
+			if (const uint8* Packed = Reader.ReadBytes(Bits * (FNumericCompactArray::BlockNum / 8)))
+			{
+				UnpackLanes(Packed, Min, Bits, Dest);
+			}
+			break;
+		}
+
+		default:
+			return false;
+		}
+
+		return Reader.bOk;
+	}
+}
+
+void FNumericCompactArray::Encode(const TArray<int32>& A, TArray<uint8>& Out)
+{
+	Out.Reset();
+	Out.Add(Version);
+	WriteVarint(Out, (uint32)A.Num());
+
+	for (int32 Start = 0; Start < A.Num(); Start += BlockNum)
+	{
+		EncodeBlock(A.GetData() + Start, FMath::Min(BlockNum, A.Num() - Start), Out);
+	}
+}
+
+bool FNumericCompactArray::Decode(TArrayView<const uint8> Data, TArray<int32>& Out)
+{
+	Out.Reset();
+	FReader Reader{ Data.GetData(), Data.GetData() + Data.Num() };
+
+	const uint8 DataVersion = Reader.ReadByte();
+	if (!Reader.bOk || DataVersion == 0 || DataVersion > Version)
+	{
+		UE_LOGFMT(LogArrayUtils, Warning, "FNumericCompactArray: Unsupported format version {0}", DataVersion);
+		return false;
+	}
+
+	// Every block takes at least two bytes, which bounds the allocation for corrupt headers.
+	const uint32 Num = Reader.ReadVarint();
+	const int64 NumBlocks = ((int64)Num + BlockNum - 1) / BlockNum;
+	if (!Reader.bOk || Num > (uint32)MAX_int32 || NumBlocks * 2 > Reader.End - Reader.Cursor)
+	{
+		UE_LOGFMT(LogArrayUtils, Warning, "FNumericCompactArray: Corrupt header, Num = {0}", Num);
+		return false;
+	}
+
+	Out.SetNumUninitialized(Num);
+	for (int32 Start = 0; Start < (int32)Num; Start += BlockNum)
+	{
+		if (!DecodeBlock(Reader, Out.GetData() + Start, FMath::Min(BlockNum, (int32)Num - Start)))
+		{
+			UE_LOGFMT(LogArrayUtils, Warning, "FNumericCompactArray: Corrupt block at element {0}", Start);
+			Out.Reset();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void FNumericCompactArray::Serialize(FArchive& Ar, TArray<int32>& A)
+{
+	TArray<uint8> Bytes;
+
+	if (Ar.IsSaving())
+	{
+		Encode(A, Bytes);
+	}
+
+	Ar << Bytes;
+
+	if (Ar.IsLoading() && !Decode(Bytes, A))
+	{
+		Ar.SetError();
+	}
+}
@@ -0,0 +1,410 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#include "NumericDispatch.h"
+#include "NumericBPLibrary.h"
+#include "NumericMatrix.h"
+#include "NumericSort.h"
+#include "NumericTransform.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/CoreDelegates.h"
+#include "Math/RandomStream.h"
+#include "Logging/StructuredLog.h"
+#include <atomic>
+
+namespace
+{
+	constexpr int32 NumThresholds = (int32)ENumericThreshold::Count;
+
+	const TCHAR* const SettingsSection = TEXT("Numeric.Dispatch");
+	const TCHAR* const ProfileSection = TEXT("Numeric.DispatchProfile");
+
+	constexpr int32 DefaultThresholds[NumThresholds] =
+	{
+		256,             // RadixSort
+		64 * 1024,       // ParallelSort
+		256 * 1024,      // ParallelTransform
+		8 * 1024 * 1024, // StreamingStore (32 MB)
+		512 * 1024,      // ParallelMatrix
+		2048,            // RadixSortValues
+	};
+
+	const TCHAR* const ThresholdNames[NumThresholds] =
+	{
+		TEXT("RadixSort"),
+		TEXT("ParallelSort"),
+		TEXT("ParallelTransform"),
+		TEXT("StreamingStore"),
+		TEXT("ParallelMatrix"),
+		TEXT("RadixSortValues"),
+	};
+
+	std::atomic<int32> Thresholds[NumThresholds] =
+	{
+		DefaultThresholds[0],
+		DefaultThresholds[1],
+		DefaultThresholds[2],
+		DefaultThresholds[3],
+		DefaultThresholds[4],
+		DefaultThresholds[5],
+	};
+
+	/**
+	 * Last value measured or loaded from the profile for each threshold, or INDEX_NONE if there is none. Kept apart from
+	 * the table so console overrides are not cached as measurements. Only touched from the game thread.
+	 */
+	int32 MeasuredThresholds[NumThresholds] = { INDEX_NONE, INDEX_NONE, INDEX_NONE, INDEX_NONE, INDEX_NONE, INDEX_NONE };
+
+	/** The streaming threshold trades raw speed for cache friendliness towards the caller, which a timing loop cannot measure. */
+	bool IsMeasurable(ENumericThreshold Threshold)
+	{
+		return Threshold != ENumericThreshold::StreamingStore;
+	}
+
+	/** Identifies the host a cached profile was measured on. */
+	FString GetHostId()
+	{
+		return FString::Printf(TEXT("%s/%d"), *FPlatformMisc::GetCPUBrand().TrimStartAndEnd(), FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+	}
+
+	/** Returns the best of three runs, in seconds. */
+	template <typename RunType>
+	double TimeBest(RunType Run)
+	{
+		double Best = MAX_dbl;
+		for (int32 Repeat = 0; Repeat < 3; ++Repeat)
+		{
+			const double Start = FPlatformTime::Seconds();
+			Run();
+			Best = FMath::Min(Best, FPlatformTime::Seconds() - Start);
+		}
+		return Best;
+	}
+
+	/** The fast path must take less than this fraction of the baseline's time to count as a win; smaller gaps are treated as noise. */
+	constexpr double WinRatio = 0.9;
+
+	/** Consecutive sizes the fast path must win at before the first of them is taken as the crossover. */
+	constexpr int32 RequiredWins = 2;
+
+	/**
+	 * Doubles the input size from MinNum to MaxNum, timing Run(Num, false) on the baseline path against Run(Num, true)
+	 * on the fast path, until the fast path clearly wins at RequiredWins sizes in a row, and publishes the first of them
+	 * as the threshold. MinNum must be large enough for the two paths to run different code. If the fast path has not
+	 * won by MaxNum, the threshold is set past MaxNum so the baseline keeps the whole measured range. If the deadline
+	 * passes first, the threshold keeps its current value.
+	 */
+	template <typename RunType>
+	void CalibrateCrossover(ENumericThreshold Threshold, int32 MinNum, int32 MaxNum, double Deadline, RunType Run)
+	{
+		int32 Crossover = 2 * MaxNum;
+		int32 FirstWin = 0;
+		int32 NumWins = 0;
+
+		for (int32 Num = MinNum; Num <= MaxNum; Num *= 2)
+		{
+			if (FPlatformTime::Seconds() >= Deadline)
+			{
+				UE_LOGFMT(LogArrayUtils, Verbose, "FNumericDispatch: Out of time before measuring {0}", FNumericDispatch::GetName(Threshold));
+				return;
+			}
+
+			const double Baseline = TimeBest([&Run, Num]() { Run(Num, false); });
+			const double Fast = TimeBest([&Run, Num]() { Run(Num, true); });
+
+			if (Fast >= Baseline * WinRatio)
+			{
+				NumWins = 0;
+				continue;
+			}
+
+			if (NumWins++ == 0)
+			{
+				FirstWin = Num;
+			}
+			if (NumWins == RequiredWins)
+			{
+				break;
+			}
+		}
+
+		// A win at the last size cannot be confirmed by the next one, but the fast path was ahead from there on.
+		if (NumWins > 0)
+		{
+			Crossover = FirstWin;
+		}
+
+		UE_LOGFMT(LogArrayUtils, Verbose, "FNumericDispatch: {0} threshold {1} -> {2}", FNumericDispatch::GetName(Threshold), FNumericDispatch::Get(Threshold), Crossover);
+		FNumericDispatch::Set(Threshold, Crossover);
+		MeasuredThresholds[(int32)Threshold] = Crossover;
+	}
+
+	void PrintTable()
+	{
+		for (int32 i = 0; i < NumThresholds; ++i)
+		{
+			UE_LOGFMT(LogArrayUtils, Display, "{0} = {1} (default {2})", ThresholdNames[i], Thresholds[i].load(std::memory_order_relaxed), DefaultThresholds[i]);
+		}
+	}
+
+	FAutoConsoleCommand PrintCommand(
+		TEXT("Numeric.Dispatch"),
+		TEXT("Prints the input sizes at which the Numeric plugin switches algorithms."),
+		FConsoleCommandDelegate::CreateStatic(&PrintTable));
+
+	FAutoConsoleCommand SetCommand(
+		TEXT("Numeric.Dispatch.Set"),
+		TEXT("Numeric.Dispatch.Set <Name> <Value>: overrides a dispatch threshold until the next calibration or restart."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			for (int32 i = 0; i < NumThresholds; ++i)
+			{
+				if (Args.Num() == 2 && Args[0] == ThresholdNames[i] && Args[1].IsNumeric())
+				{
+					FNumericDispatch::Set((ENumericThreshold)i, FCString::Atoi(*Args[1]));
+					PrintTable();
+					return;
+				}
+			}
+			UE_LOGFMT(LogArrayUtils, Warning, "Numeric.Dispatch.Set: Usage is Numeric.Dispatch.Set <Name> <Value>, with Name one of RadixSort, ParallelSort, ParallelTransform, StreamingStore, ParallelMatrix, RadixSortValues");
+		}));
+
+	FAutoConsoleCommand CalibrateCommand(
+		TEXT("Numeric.Dispatch.Calibrate"),
+		TEXT("Numeric.Dispatch.Calibrate [BudgetMs]: measures the dispatch thresholds on this host and caches them."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			const int32 BudgetMs = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000;
+			FNumericDispatch::Calibrate(BudgetMs / 1000.0);
+			FNumericDispatch::SaveProfile();
+			PrintTable();
+		}));
+
+	FAutoConsoleCommand ResetCommand(
+		TEXT("Numeric.Dispatch.Reset"),
+		TEXT("Restores the built-in dispatch thresholds. The next calibration measures all of them again."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			FNumericDispatch::ResetToDefaults();
+			PrintTable();
+		}));
+}
+
+int32 FNumericDispatch::Get(ENumericThreshold Threshold)
+{
+	return Thresholds[(int32)Threshold].load(std::memory_order_relaxed);
+}
+
+void FNumericDispatch::Set(ENumericThreshold Threshold, int32 Value)
+{
+	Thresholds[(int32)Threshold].store(FMath::Max(Value, 0), std::memory_order_relaxed);
+}
+
+int32 FNumericDispatch::NumParallelChunks(ENumericThreshold Threshold, int64 Work, int64 MinChunkWork)
+{
+	return Work < Get(Threshold) ? 1 : MaxParallelChunks(Work, MinChunkWork);
+}
+
+int32 FNumericDispatch::MaxParallelChunks(int64 Work, int64 MinChunkWork)
+{
+	if (!FTaskGraphInterface::IsRunning())
+	{
+		return 1;
+	}
+	return (int32)FMath::Clamp<int64>(Work / MinChunkWork, 1, FTaskGraphInterface::Get().GetNumWorkerThreads() + 1);
+}
+
+void FNumericDispatch::ResetToDefaults()
+{
+	for (int32 i = 0; i < NumThresholds; ++i)
+	{
+		Set((ENumericThreshold)i, DefaultThresholds[i]);
+		MeasuredThresholds[i] = INDEX_NONE;
+	}
+}
+
+const TCHAR* FNumericDispatch::GetName(ENumericThreshold Threshold)
+{
+	return (int32)Threshold < NumThresholds ? ThresholdNames[(int32)Threshold] : nullptr;
+}
+
+void FNumericDispatch::Calibrate(double BudgetSeconds, bool bMissingOnly)
+{
+	const double Start = FPlatformTime::Seconds();
+	const double Deadline = Start + BudgetSeconds;
+
+	// Each sweep runs well past its threshold's default, so a crossover above the default can be found too.
+	constexpr int32 MaxSortNum = 1024 * 1024;
+	constexpr int32 MaxTransformNum = 4 * 1024 * 1024;
+	constexpr int32 MaxMatrixWork = 8 * 1024 * 1024;
+
+	FRandomStream Random(0x5EED);
+	TArray<int32> Keys;
+	Keys.SetNumUninitialized(MaxTransformNum);
+	for (int32& Key : Keys)
+	{
+		Key = (int32)Random.GetUnsignedInt();
+	}
+
+	auto ShouldMeasure = [bMissingOnly](ENumericThreshold Threshold)
+	{
+		return !bMissingOnly || MeasuredThresholds[(int32)Threshold] == INDEX_NONE;
+	};
+
+	// The radix crossovers are measured on the serial paths, the parallel sort crossover on the radix path.
+	if (ShouldMeasure(ENumericThreshold::RadixSort))
+	{
+		CalibrateCrossover(ENumericThreshold::RadixSort, 32, 64 * 1024, Deadline, [&Keys](int32 Num, bool bFast)
+		{
+			FNumericSort::ArgSort(MakeArrayView(Keys.GetData(), Num), bFast, 1);
+		});
+	}
+
+	// Sorting plain values copies them first, which costs both paths the same.
+	if (ShouldMeasure(ENumericThreshold::RadixSortValues))
+	{
+		TArray<int32> Values;
+		CalibrateCrossover(ENumericThreshold::RadixSortValues, 32, 64 * 1024, Deadline, [&Keys, &Values](int32 Num, bool bFast)
+		{
+			Values = TArray<int32>(Keys.GetData(), Num);
+			FNumericSort::Sort(Values, false, bFast, 1);
+		});
+	}
+
+	// Parallel crossovers can only be measured once the worker threads are up. Below two chunks' worth of work both
+	// paths run the same serial code, so each sweep starts at twice the smallest chunk.
+	if (!FTaskGraphInterface::IsRunning())
+	{
+		UE_LOGFMT(LogArrayUtils, Log, "FNumericDispatch: Worker threads are not running, so the parallel thresholds were not measured");
+	}
+	else
+	{
+		if (ShouldMeasure(ENumericThreshold::ParallelSort))
+		{
+			CalibrateCrossover(ENumericThreshold::ParallelSort, 2 * FNumericSort::MinChunkNum, MaxSortNum, Deadline, [&Keys](int32 Num, bool bFast)
+			{
+				FNumericSort::ArgSort(MakeArrayView(Keys.GetData(), Num), true, bFast ? MaxParallelChunks(Num, FNumericSort::MinChunkNum) : 1);
+			});
+		}
+
+		if (ShouldMeasure(ENumericThreshold::ParallelTransform))
+		{
+			TArray<int32> Output;
+			Output.SetNumUninitialized(MaxTransformNum);
+			const int32* Source = Keys.GetData();
+			CalibrateCrossover(ENumericThreshold::ParallelTransform, 2 * FNumericTransform::MinChunkNum, MaxTransformNum, Deadline, [&Output, Source](int32 Num, bool bFast)
+			{
+				const bool bStreaming = Num >= Get(ENumericThreshold::StreamingStore);
+				FNumericTransform::Generate(Output.GetData(), Num, [Source](int32 i) { return FMath::Clamp(Source[i], -1024, 1024); }, bFast ? MaxParallelChunks(Num, FNumericTransform::MinChunkNum) : 1, bStreaming);
+			});
+		}
+
+		// Matrix products are compute bound, so they get their own crossover, measured in multiply-adds on products with
+		// a MatrixSide x MatrixSide right-hand side. Entries are kept to 16 bits so the int64 sums cannot overflow.
+		if (ShouldMeasure(ENumericThreshold::ParallelMatrix))
+		{
+			constexpr int32 MatrixSide = 64;
+			TArray<int32> Matrix;
+			Matrix.SetNumUninitialized(MaxMatrixWork / MatrixSide);
+			for (int32 i = 0; i < Matrix.Num(); ++i)
+			{
+				Matrix[i] = Keys[i] >> 16;
+			}
+			TArray<int64> Products;
+			Products.SetNumUninitialized(MaxMatrixWork / MatrixSide);
+			CalibrateCrossover(ENumericThreshold::ParallelMatrix, (int32)(2 * FNumericMatrix::MinChunkWork), MaxMatrixWork, Deadline, [&Matrix, &Products](int32 Num, bool bFast)
+			{
+				const int32 NumRows = Num / (MatrixSide * MatrixSide);
+				FNumericMatrix::MatrixMultiply(MakeArrayView(Matrix.GetData(), NumRows * MatrixSide), MakeArrayView(Matrix.GetData(), MatrixSide * MatrixSide),
+					NumRows, MatrixSide, MatrixSide, Products.GetData(), bFast ? MaxParallelChunks(Num, FNumericMatrix::MinChunkWork) : 1);
+			});
+		}
+	}
+
+	UE_LOGFMT(LogArrayUtils, Log, "FNumericDispatch: Calibrated in {0} ms", (int32)((FPlatformTime::Seconds() - Start) * 1000.0));
+}
+
+bool FNumericDispatch::LoadProfile()
+{
+	FString HostId;
+	if (!GConfig || !GConfig->GetString(ProfileSection, TEXT("HostId"), HostId, GEngineIni) || HostId != GetHostId())
+	{
+		return false;
+	}
+
+	bool bComplete = true;
+	for (int32 i = 0; i < NumThresholds; ++i)
+	{
+		int32 Value = 0;
+		if (GConfig->GetInt(ProfileSection, ThresholdNames[i], Value, GEngineIni))
+		{
+			Set((ENumericThreshold)i, Value);
+			MeasuredThresholds[i] = Get((ENumericThreshold)i);
+		}
+		else
+		{
+			bComplete &= !IsMeasurable((ENumericThreshold)i);
+		}
+	}
+
+	return bComplete;
+}
+
+void FNumericDispatch::SaveProfile()
+{
+	if (!GConfig)
+	{
+		return;
+	}
+
+	GConfig->SetString(ProfileSection, TEXT("HostId"), *GetHostId(), GEngineIni);
+	for (int32 i = 0; i < NumThresholds; ++i)
+	{
+		if (MeasuredThresholds[i] != INDEX_NONE)
+		{
+			GConfig->SetInt(ProfileSection, ThresholdNames[i], MeasuredThresholds[i], GEngineIni);
+		}
+		else
+		{
+			GConfig->RemoveKey(ProfileSection, ThresholdNames[i], GEngineIni);
+		}
+	}
+	GConfig->Flush(false, GEngineIni);
+}
+
+void FNumericDispatch::Startup()
+{
+	if (!GConfig || LoadProfile())
+	{
+		return;
+	}
+
+	bool bCalibrateOnStartup = false;
+	int32 CalibrationBudgetMs = 250;
+	GConfig->GetBool(SettingsSection, TEXT("bCalibrateOnStartup"), bCalibrateOnStartup, GEngineIni);
+	GConfig->GetInt(SettingsSection, TEXT("CalibrationBudgetMs"), CalibrationBudgetMs, GEngineIni);
+
+	if (!bCalibrateOnStartup)
+	{
+		return;
+	}
+
+	// Only the thresholds missing from the profile are measured, so a budget too small for all of them still completes
+	// the profile over a few runs.
+	auto CalibrateAndSave = [CalibrationBudgetMs]()
+	{
+		Calibrate(CalibrationBudgetMs / 1000.0, true);
+		SaveProfile();
+	};
+
+	// The module can load before the worker threads start, and the parallel crossovers cannot be measured without them.
+	if (FTaskGraphInterface::IsRunning())
+	{
+		CalibrateAndSave();
+	}
+	else
+	{
+		FCoreDelegates::OnPostEngineInit.AddLambda(CalibrateAndSave);
+	}
+}
@@ -0,0 +1,97 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#include "NumericFileStream.h"
+#include "Async/Async.h"
+#include "HAL/PlatformFileManager.h"
+#include "NumericBPLibrary.h"
+#include "Logging/StructuredLog.h"
+
+FNumericFileStream::FNumericFileStream(const FString& InPath, int32 InChunkNum)
+	: Path(InPath)
+	, ChunkNum(FMath::Max(InChunkNum, 1))
+	, NumElements(-1)
+{
+	const int64 FileSize = FPlatformFileManager::Get().GetPlatformFile().FileSize(*Path);
+
+	if (FileSize >= 0 && FileSize % sizeof(int32) == 0)
+	{
+		NumElements = FileSize / sizeof(int32);
+	}
+	else
+	{
+		UE_LOGFMT(LogArrayUtils, Warning, "FNumericFileStream: {0} is missing or not a whole number of int32 elements. Size = {1}", Path, FileSize);
+	}
+}
+
+bool FNumericFileStream::ForEachChunk(TFunctionRef<bool(const int32* Data, int32 Num, int64 FirstIndex)> Visitor, int32 Overlap) const
+{
+	if (!IsValid())
+	{
+		return false;
+	}
+
+	TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*Path));
+	if (!Handle)
+	{
+		UE_LOGFMT(LogArrayUtils, Warning, "FNumericFileStream: Could not open {0}", Path);
+		return false;
+	}
+
+	Overlap = FMath::Max(Overlap, 0);
+
+	// Each buffer reserves Overlap slots in front of the chunk for the tail carried over from the previous chunk.
+	TArray<int32> Buffers[2];
+	Buffers[0].SetNumUninitialized(Overlap + ChunkNum);
+	Buffers[1].SetNumUninitialized(Overlap + ChunkNum);
+
+	// Reads the chunk starting at Start into Dest. Returns the number of elements read, or -1 on failure.
+	auto ReadChunk = [&Handle, this](int32* Dest, int64 Start) -> int32
+	{
+		const int32 Count = (int32)FMath::Min<int64>(ChunkNum, NumElements - Start);
+		if (Count > 0 && !Handle->Read(reinterpret_cast<uint8*>(Dest), (int64)Count * sizeof(int32)))
+		{
+			return -1;
+		}
+		return FMath::Max(Count, 0);
+	};
+
+	int32 Current = 0;
+	int64 Start = 0;
+	int32 Carry = 0;
+	int32 Count = ReadChunk(Buffers[Current].GetData() + Overlap, Start);
+
+	while (Count > 0)
+	{
+		// Read the next chunk ahead while the visitor processes the current one.
+		const int32 Next = 1 - Current;
+		const int64 NextStart = Start + Count;
+		int32* NextDest = Buffers[Next].GetData() + Overlap;
+		TFuture<int32> Pending = Async(EAsyncExecution::ThreadPool, [&ReadChunk, NextDest, NextStart]() { return ReadChunk(NextDest, NextStart); });
+
+		const int32* Data = Buffers[Current].GetData() + Overlap - Carry;
+		const bool bContinue = Visitor(Data, Carry + Count, Start - Carry);
+
+		const int32 NextCount = Pending.Get();
+		if (NextCount < 0)
+		{
+			UE_LOGFMT(LogArrayUtils, Warning, "FNumericFileStream: Read failed on {0} at element {1}", Path, NextStart);
+			return false;
+		}
+
+		if (!bContinue)
+		{
+			return true;
+		}
+
+		// Carry the tail of the current window in front of the next chunk.
+		const int32 NextCarry = FMath::Min(Overlap, Carry + Count);
+		FMemory::Memcpy(NextDest - NextCarry, Data + Carry + Count - NextCarry, NextCarry * sizeof(int32));
+
+		Current = Next;
+		Start = NextStart;
+		Carry = NextCarry;
+		Count = NextCount;
+	}
+
+	return Count == 0;
+}
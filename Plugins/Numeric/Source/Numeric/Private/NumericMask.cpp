@@ -0,0 +1,83 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#include "NumericMask.h"
+
+FNumericMask::FNumericMask(int32 InNum, bool bValue)
+	: Count(FMath::Max(InNum, 0))
+{
+	Words.Init(bValue ? ~0u : 0u, FMath::DivideAndRoundUp(Count, BitsPerWord));
+	if (bValue && Count % BitsPerWord != 0)
+	{
+		Words.Last() = (1u << (Count % BitsPerWord)) - 1;
+	}
+}
+
+int32 FNumericMask::CountSetBits() const
+{
+	int32 Total = 0;
+	for (const uint32 Word : Words)
+	{
+		Total += (int32)FMath::CountBits(Word);
+	}
+	return Total;
+}
+
+FNumericMask FNumericMask::operator&(const FNumericMask& Other) const
+{
+	check(Count == Other.Count);
+
+	FNumericMask Result = *this;
+	for (int32 i = 0; i < Words.Num(); ++i)
+	{
+		Result.Words[i] &= Other.Words[i];
+	}
+	return Result;
+}
+
+FNumericMask FNumericMask::operator|(const FNumericMask& Other) const
+{
+	check(Count == Other.Count);
+
+	FNumericMask Result = *this;
+	for (int32 i = 0; i < Words.Num(); ++i)
+	{
+		Result.Words[i] |= Other.Words[i];
+	}
+	return Result;
+}
+
+FNumericMask FNumericMask::operator~() const
+{
+	FNumericMask Result = *this;
+	for (uint32& Word : Result.Words)
+	{
+		Word = ~Word;
+	}
+
+	// Keep the bits past Num clear so counting and selecting never see them.
+	if (Count % BitsPerWord != 0)
+	{
+		Result.Words.Last() &= (1u << (Count % BitsPerWord)) - 1;
+	}
+	return Result;
+}
+
+TArray<int32> FNumericMask::Select(TArrayView<const int32> A) const
+{
+	check(A.Num() == Count);
+
+	TArray<int32> Result;
+	Result.SetNumUninitialized(CountSetBits());
+	int32* Out = Result.GetData();
+	ForEachSetBit([&Out, &A](int32 Index) { *Out++ = A[Index]; });
+	return Result;
+}
+
+TArray<int32> FNumericMask::Indices() const
+{
+	TArray<int32> Result;
+	Result.SetNumUninitialized(CountSetBits());
+	int32* Out = Result.GetData();
+	ForEachSetBit([&Out](int32 Index) { *Out++ = Index; });
+	return Result;
+}
@@ -0,0 +1,132 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#include "NumericMatrix.h"
+#include "NumericDispatch.h"
+
+namespace
+{
+	/** Rows of the matrix that share each load of the vector in MatrixVector. */
+	constexpr int32 RowBlock = 4;
+
+	/** Tile of B kept hot in cache by MatrixMultiply: KBlock rows of NBlock columns, 128 KB. */
+	constexpr int32 KBlock = 128;
+	constexpr int32 NBlock = 256;
+
+	/** Returns how many ranges to split NumRows rows of WorkPerRow multiply-adds each into. */
+	int32 NumRowChunks(int32 NumRows, int64 WorkPerRow)
+	{
+		return FNumericDispatch::NumParallelChunks(ENumericThreshold::ParallelMatrix, NumRows * WorkPerRow, FNumericMatrix::MinChunkWork);
+	}
+
+	/**
+	 * Runs Body(BeginRow, EndRow) over [0, NumRows) in at most NumChunks ranges, on worker threads when there are several.
+	 * If Out is given, with OutRowSize bytes per row, range boundaries fall on its cache lines.
+	 */
+	template <typename BodyType>
+	void ForEachRowRange(int32 NumRows, int32 NumChunks, BodyType Body, const void* Out = nullptr, int32 OutRowSize = 1)
+	{
+		FNumericDispatch::ParallelRanges(NumRows, FMath::Min(NumRows, NumChunks), Body, Out, OutRowSize);
+	}
+}
+
+int64 FNumericMatrix::Dot(const int32* A, const int32* B, int32 Num)
+{
+	// Independent accumulators break the dependency on a single sum so the loop pipelines and vectorizes.
+	int64 Sum0 = 0, Sum1 = 0, Sum2 = 0, Sum3 = 0;
+	int32 i = 0;
+	for (; i + 4 <= Num; i += 4)
+	{
+		Sum0 += (int64)A[i] * B[i];
+		Sum1 += (int64)A[i + 1] * B[i + 1];
+		Sum2 += (int64)A[i + 2] * B[i + 2];
+		Sum3 += (int64)A[i + 3] * B[i + 3];
+	}
+	for (; i < Num; ++i)
+	{
+		Sum0 += (int64)A[i] * B[i];
+	}
+	return (Sum0 + Sum1) + (Sum2 + Sum3);
+}
+
+void FNumericMatrix::MatrixVector(TArrayView<const int32> Matrix, int32 NumRows, TArrayView<const int32> Vector, int64* Out)
+{
+	const int32 NumColumns = Vector.Num();
+	check((int64)NumRows * NumColumns == Matrix.Num());
+
+	const int32* Rows = Matrix.GetData();
+	const int32* X = Vector.GetData();
+	ForEachRowRange(NumRows, NumRowChunks(NumRows, NumColumns), [Rows, X, NumColumns, Out](int32 BeginRow, int32 EndRow)
+	{
+		int32 Row = BeginRow;
+
+		// Each element of the vector is loaded once per block of rows instead of once per row.
+		for (; Row + RowBlock <= EndRow; Row += RowBlock)
+		{
+			const int32* R0 = Rows + (int64)Row * NumColumns;
+			const int32* R1 = R0 + NumColumns;
+			const int32* R2 = R1 + NumColumns;
+			const int32* R3 = R2 + NumColumns;
+
+			int64 Sum0 = 0, Sum1 = 0, Sum2 = 0, Sum3 = 0;
+			for (int32 Column = 0; Column < NumColumns; ++Column)
+			{
+				const int64 Value = X[Column];
+				Sum0 += R0[Column] * Value;
+				Sum1 += R1[Column] * Value;
+				Sum2 += R2[Column] * Value;
+				Sum3 += R3[Column] * Value;
+			}
+			Out[Row] = Sum0;
+			Out[Row + 1] = Sum1;
+			Out[Row + 2] = Sum2;
+			Out[Row + 3] = Sum3;
+		}
+
+		for (; Row < EndRow; ++Row)
+		{
+			Out[Row] = Dot(Rows + (int64)Row * NumColumns, X, NumColumns);
+		}
+	}, Out, sizeof(int64));
+}
+
+void FNumericMatrix::MatrixMultiply(TArrayView<const int32> A, TArrayView<const int32> B, int32 M, int32 K, int32 N, int64* Out)
+{
+	MatrixMultiply(A, B, M, K, N, Out, NumRowChunks(M, (int64)K * N));
+}
+
+void FNumericMatrix::MatrixMultiply(TArrayView<const int32> A, TArrayView<const int32> B, int32 M, int32 K, int32 N, int64* Out, int32 NumChunks)
+{
+	check((int64)M * K == A.Num() && (int64)K * N == B.Num());
+
+	const int32* Left = A.GetData();
+	const int32* Right = B.GetData();
+	ForEachRowRange(M, NumChunks, [Left, Right, K, N, Out](int32 BeginRow, int32 EndRow)
+	{
+		FMemory::Memzero(Out + (int64)BeginRow * N, (SIZE_T)(EndRow - BeginRow) * N * sizeof(int64));
+
+		// Walk B in tiles small enough to stay in cache while every row of this range is multiplied against them.
+		// The innermost loop runs along a row of B and of the output, so both are read and written contiguously.
+		for (int32 KBegin = 0; KBegin < K; KBegin += KBlock)
+		{
+			const int32 KEnd = FMath::Min(K, KBegin + KBlock);
+			for (int32 NBegin = 0; NBegin < N; NBegin += NBlock)
+			{
+				const int32 NEnd = FMath::Min(N, NBegin + NBlock);
+				for (int32 Row = BeginRow; Row < EndRow; ++Row)
+				{
+					int64* OutRow = Out + (int64)Row * N;
+					const int32* LeftRow = Left + (int64)Row * K;
+					for (int32 Inner = KBegin; Inner < KEnd; ++Inner)
+					{
+						const int64 Value = LeftRow[Inner];
+						const int32* RightRow = Right + (int64)Inner * N;
+						for (int32 Column = NBegin; Column < NEnd; ++Column)
+						{
+							OutRow[Column] += Value * RightRow[Column];
+						}
+					}
+				}
+			}
+		}
+	});
+}
@@ -0,0 +1,75 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#include "NumericSlidingWindow.h"
+
+FNumericSlidingWindow::FNumericSlidingWindow(int32 InWindowSize)
+	: WindowSize(FMath::Max(InWindowSize, 1))
+{
+	Reset();
+}
+
+void FNumericSlidingWindow::Reset()
+{
+	Samples.SetNumZeroed(WindowSize);
+	Count = 0;
+	NextSlot = 0;
+	NextIndex = 0;
+	RunningSum = 0;
+	MinQueue.Init(WindowSize);
+	MaxQueue.Init(WindowSize);
+}
+
+void FNumericSlidingWindow::Push(int32 Sample)
+{
+	if (WindowSize <= 0)
+	{
+		return;
+	}
+
+	int32& Slot = Samples[NextSlot];
+	if (Count == WindowSize)
+	{
+		RunningSum -= Slot;
+	}
+	else
+	{
+		++Count;
+	}
+
+	Slot = Sample;
+	RunningSum += Sample;
+
+	MinQueue.Push(NextIndex, Sample, WindowSize, [](int32 New, int32 Old) { return New <= Old; });
+	MaxQueue.Push(NextIndex, Sample, WindowSize, [](int32 New, int32 Old) { return New >= Old; });
+	NextSlot = NextSlot + 1 < WindowSize ? NextSlot + 1 : 0;
+	++NextIndex;
+}
+
+void FNumericSlidingWindow::FMonotonicQueue::Init(int32 Capacity)
+{
+	Items.SetNumZeroed(Capacity);
+	Head = 0;
+	Num = 0;
+}
+
+template <typename DominatesType>
+void FNumericSlidingWindow::FMonotonicQueue::Push(int64 Index, int32 Value, int32 WindowSize, DominatesType Dominates)
+{
+	const int32 Capacity = Items.Num();
+
+	// Evict the front once it is older than the window.
+	if (Num > 0 && Items[Head].Key <= Index - WindowSize)
+	{
+		Head = (Head + 1) % Capacity;
+		--Num;
+	}
+
+	// Entries the new value dominates can never be the answer again.
+	while (Num > 0 && Dominates(Value, Items[(Head + Num - 1) % Capacity].Value))
+	{
+		--Num;
+	}
+
+	Items[(Head + Num) % Capacity] = TPair<int64, int32>(Index, Value);
+	++Num;
+}
@@ -0,0 +1,186 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#include "NumericSort.h"
+#include "NumericDispatch.h"
+#include "Algo/Sort.h"
+#include "Algo/StableSort.h"
+
+namespace
+{
+	constexpr int32 RadixBits = 8;
+	constexpr int32 RadixBuckets = 1 << RadixBits;
+
+	/**
+	 * Stable LSD radix sort of Items by the 32-bit unsigned key in bits [FirstShift, FirstShift + 32) of each item.
+	 * Each pass histograms per chunk, turns the histograms into per-chunk output offsets, then scatters every chunk
+	 * independently, so chunks run in parallel and stay stable.
+	 */
+	template <typename T>
+	void RadixSort(TArray<T>& Items, int32 FirstShift, int32 NumChunks)
+	{
+		const int32 Num = Items.Num();
+
+		TArray<T> Scratch;
+		Scratch.SetNumUninitialized(Num);
+		TArray<int32> Offsets;
+		Offsets.SetNumUninitialized(NumChunks * RadixBuckets);
+
+		auto ChunkBegin = [Num, NumChunks](int32 Chunk) { return (int32)((int64)Num * Chunk / NumChunks); };
+
+		T* Source = Items.GetData();
+		T* Dest = Scratch.GetData();
+
+		for (int32 Shift = FirstShift; Shift < FirstShift + 32; Shift += RadixBits)
+		{
+			ParallelFor(NumChunks, [&](int32 Chunk)
+			{
+				int32* Histogram = Offsets.GetData() + Chunk * RadixBuckets;
+				FMemory::Memzero(Histogram, RadixBuckets * sizeof(int32));
+				for (int32 i = ChunkBegin(Chunk); i < ChunkBegin(Chunk + 1); ++i)
+				{
+					++Histogram[(Source[i] >> Shift) & (RadixBuckets - 1)];
+				}
+			}, NumChunks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+			// Turn counts into offsets, bucket-major so chunk order is preserved within each bucket.
+			int32 Total = 0;
+			bool bSingleBucket = false;
+			for (int32 Bucket = 0; Bucket < RadixBuckets; ++Bucket)
+			{
+				const int32 BucketStart = Total;
+				for (int32 Chunk = 0; Chunk < NumChunks; ++Chunk)
+				{
+					int32& Slot = Offsets[Chunk * RadixBuckets + Bucket];
+					const int32 Count = Slot;
+					Slot = Total;
+					Total += Count;
+				}
+				bSingleBucket |= Total - BucketStart == Num;
+			}
+
+			// Every key shares this digit, so the pass would not move anything.
+			if (bSingleBucket)
+			{
+				continue;
+			}
+
+			ParallelFor(NumChunks, [&](int32 Chunk)
+			{
+				int32* Offset = Offsets.GetData() + Chunk * RadixBuckets;
+				for (int32 i = ChunkBegin(Chunk); i < ChunkBegin(Chunk + 1); ++i)
+				{
+					Dest[Offset[(Source[i] >> Shift) & (RadixBuckets - 1)]++] = Source[i];
+				}
+			}, NumChunks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+			Swap(Source, Dest);
+		}
+
+		if (Source != Items.GetData())
+		{
+			Items = MoveTemp(Scratch);
+		}
+	}
+}
+
+TArray<int32> FNumericSort::ArgSort(TArrayView<const int32> Keys)
+{
+	return ArgSort(Keys, Keys.Num() >= FNumericDispatch::Get(ENumericThreshold::RadixSort), NumParallelChunks(Keys.Num()));
+}
+
+TArray<int32> FNumericSort::ArgSort(TArrayView<const int32> Keys, bool bRadix, int32 NumChunks)
+{
+	TArray<int32> Order;
+	Order.SetNumUninitialized(Keys.Num());
+
+	if (!bRadix)
+	{
+		for (int32 i = 0; i < Keys.Num(); ++i)
+		{
+			Order[i] = i;
+		}
+		Algo::StableSort(Order, [&Keys](int32 X, int32 Y) { return Keys[X] < Keys[Y]; });
+		return Order;
+	}
+
+	// (key, index) pairs packed as key << 32 | index, with the key's sign bit flipped so unsigned order matches signed order.
+	TArray<uint64> Pairs;
+	Pairs.SetNumUninitialized(Keys.Num());
+	FNumericDispatch::ParallelRanges(Keys.Num(), NumChunks, [&Pairs, &Keys](int32 Begin, int32 End)
+	{
+		for (int32 i = Begin; i < End; ++i)
+		{
+			Pairs[i] = ((uint64)((uint32)Keys[i] ^ 0x80000000u) << 32) | (uint32)i;
+		}
+	});
+
+	RadixSort(Pairs, 32, NumChunks);
+
+	FNumericDispatch::ParallelRanges(Keys.Num(), NumChunks, [&Pairs, &Order](int32 Begin, int32 End)
+	{
+		for (int32 i = Begin; i < End; ++i)
+		{
+			Order[i] = (int32)(uint32)Pairs[i];
+		}
+	});
+
+	return Order;
+}
+
+void FNumericSort::Sort(TArrayView<int32> Values, bool bDescending)
+{
+	Sort(Values, bDescending, Values.Num() >= FNumericDispatch::Get(ENumericThreshold::RadixSortValues), NumParallelChunks(Values.Num()));
+}
+
+void FNumericSort::Sort(TArrayView<int32> Values, bool bDescending, bool bRadix, int32 NumChunks)
+{
+	if (!bRadix)
+	{
+		if (bDescending)
+		{
+			Algo::Sort(Values, TGreater<int32>());
+		}
+		else
+		{
+			Algo::Sort(Values);
+		}
+		return;
+	}
+
+	// Flipping the sign bit makes unsigned order match signed order; flipping the other bits as well reverses it.
+	const uint32 Flip = bDescending ? 0x7FFFFFFFu : 0x80000000u;
+
+	TArray<uint32> Keys;
+	Keys.SetNumUninitialized(Values.Num());
+	FNumericDispatch::ParallelRanges(Values.Num(), NumChunks, [&Keys, &Values, Flip](int32 Begin, int32 End)
+	{
+		for (int32 i = Begin; i < End; ++i)
+		{
+			Keys[i] = (uint32)Values[i] ^ Flip;
+		}
+	});
+
+	RadixSort(Keys, 0, NumChunks);
+
+	FNumericDispatch::ParallelRanges(Values.Num(), NumChunks, [&Keys, &Values, Flip](int32 Begin, int32 End)
+	{
+		for (int32 i = Begin; i < End; ++i)
+		{
+			Values[i] = (int32)(Keys[i] ^ Flip);
+		}
+	});
+}
+
+bool FNumericSort::IsPermutation(TArrayView<const int32> Permutation)
+{
+	TBitArray<> Seen(false, Permutation.Num());
+	for (const int32 Index : Permutation)
+	{
+		if (Index < 0 || Index >= Permutation.Num() || Seen[Index])
+		{
+			return false;
+		}
+		Seen[Index] = true;
+	}
+	return true;
+}
@@ -0,0 +1,111 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#include "NumericSortedIndex.h"
+
+namespace
+{
+	/** Number of queries advanced in lockstep by the batched lookup. */
+	constexpr int32 BatchNum = 16;
+
+	/** Eytzinger slots 16 * K to 16 * K + 15 hold the descendants of K four levels down: one cache line. */
+	constexpr int32 PrefetchStride = 16;
+
+	/** Fills the subtree rooted at Slot with the next elements of Sorted, in order. */
+	void BuildSubtree(TArrayView<const int32> Sorted, int32& Next, int32 Slot, TArray<int32>& Layout, TArray<int32>& Ranks)
+	{
+		if (Slot < Layout.Num())
+		{
+			BuildSubtree(Sorted, Next, 2 * Slot, Layout, Ranks);
+			Layout[Slot] = Sorted[Next];
+			Ranks[Slot] = Next++;
+			BuildSubtree(Sorted, Next, 2 * Slot + 1, Layout, Ranks);
+		}
+	}
+
+	/**
+	 * Maps the slot a search ended on back to the answer. Each right turn appended a 1 bit; dropping the trailing
+	 * right turns and the last left turn gives the last element that was not less than the value, or slot 0 if none.
+	 */
+	int32 ResolveSlot(uint32 Slot)
+	{
+		return (int32)(Slot >> (FMath::CountTrailingZeros(~Slot) + 1));
+	}
+}
+
+FNumericSortedIndex::FNumericSortedIndex(TArrayView<const int32> Sorted)
+{
+	Layout.SetNumUninitialized(Sorted.Num() + 1);
+	Ranks.SetNumUninitialized(Sorted.Num() + 1);
+
+	Layout[0] = 0;
+	Ranks[0] = Sorted.Num();
+
+	int32 Next = 0;
+	BuildSubtree(Sorted, Next, 1, Layout, Ranks);
+}
+
+int32 FNumericSortedIndex::LowerBound(int32 Value) const
+{
+	const uint32 Num = (uint32)this->Num();
+	if (Num == 0)
+	{
+		return 0;
+	}
+
+	const int32* Data = Layout.GetData();
+	uint32 Slot = 1;
+	while (Slot <= Num)
+	{
+		FPlatformMisc::Prefetch(Data + (SIZE_T)PrefetchStride * Slot);
+		Slot = 2 * Slot + (Data[Slot] < Value);
+	}
+
+	return Ranks[ResolveSlot(Slot)];
+}
+
+TArray<int32> FNumericSortedIndex::LowerBound(TArrayView<const int32> Values) const
+{
+	TArray<int32> Result;
+	Result.SetNumUninitialized(Values.Num());
+
+	const uint32 Num = (uint32)this->Num();
+	if (Num == 0)
+	{
+		FMemory::Memzero(Result.GetData(), Result.Num() * sizeof(int32));
+		return Result;
+	}
+
+	// Every search ends after at most this many levels, so the whole batch can advance one level at a time.
+	const int32 Levels = FMath::FloorLog2(Num) + 1;
+	const int32* Data = Layout.GetData();
+
+	for (int32 Start = 0; Start < Values.Num(); Start += BatchNum)
+	{
+		const int32 Count = FMath::Min(BatchNum, Values.Num() - Start);
+		uint32 Slots[BatchNum];
+
+		for (int32 j = 0; j < Count; ++j)
+		{
+			Slots[j] = 1;
+		}
+
+		for (int32 Level = 0; Level < Levels; ++Level)
+		{
+			for (int32 j = 0; j < Count; ++j)
+			{
+				if (Slots[j] <= Num)
+				{
+					FPlatformMisc::Prefetch(Data + (SIZE_T)PrefetchStride * Slots[j]);
+					Slots[j] = 2 * Slots[j] + (Data[Slots[j]] < Values[Start + j]);
+				}
+			}
+		}
+
+		for (int32 j = 0; j < Count; ++j)
+		{
+			Result[Start + j] = Ranks[ResolveSlot(Slots[j])];
+		}
+	}
+
+	return Result;
+}
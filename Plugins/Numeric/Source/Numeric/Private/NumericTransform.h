@@ -0,0 +1,72 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NumericDispatch.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+#include <emmintrin.h>
+#endif
+
+/**
+ * Writes generated int32 values into an output buffer as fast as memory allows: outputs from ENumericThreshold::ParallelTransform
+ * elements are split across worker threads, and outputs from ENumericThreshold::StreamingStore elements (larger than the
+ * last-level cache) are written with non-temporal stores so they do not evict the caller's working set. Elementwise
+ * functions such as Fill, Iota and Clamp are expressed as generators.
+ */
+struct FNumericTransform
+{
+	/** Generators are handed to worker threads in chunks of at least this many outputs. */
+	static constexpr int32 MinChunkNum = 64 * 1024;
+
+	/** Sets Out[i] = Generator(i) for every i in [0, Num). Generator must be safe to call from several threads. */
+	template <typename GeneratorType>
+	static void Generate(int32* Out, int32 Num, GeneratorType Generator)
+	{
+		const bool bStreaming = Num >= FNumericDispatch::Get(ENumericThreshold::StreamingStore);
+		Generate(Out, Num, Generator, FNumericDispatch::NumParallelChunks(ENumericThreshold::ParallelTransform, Num, MinChunkNum), bStreaming);
+	}
+
+	/** Generate split into NumChunks ranges and with or without streaming stores, regardless of the dispatch table. */
+	template <typename GeneratorType>
+	static void Generate(int32* Out, int32 Num, GeneratorType Generator, int32 NumChunks, bool bStreaming)
+	{
+		// Chunk boundaries fall on cache lines of the output, so no two threads write to the same line.
+		FNumericDispatch::ParallelRanges(Num, NumChunks, [Out, &Generator, bStreaming](int32 Begin, int32 End)
+		{
+			GenerateRange(Out, Begin, End, Generator, bStreaming);
+		}, Out, sizeof(int32));
+	}
+
+private:
+	template <typename GeneratorType>
+	static void GenerateRange(int32* Out, int32 Begin, int32 End, GeneratorType& Generator, bool bStreaming)
+	{
+		int32 i = Begin;
+
+#if PLATFORM_CPU_X86_FAMILY
+		if (bStreaming)
+		{
+			// Streaming stores need 16-byte alignment.
+			for (; i < End && !IsAligned(Out + i, 16); ++i)
+			{
+				Out[i] = Generator(i);
+			}
+
+			for (; i + 4 <= End; i += 4)
+			{
+				_mm_stream_si128(reinterpret_cast<__m128i*>(Out + i), _mm_setr_epi32(Generator(i), Generator(i + 1), Generator(i + 2), Generator(i + 3)));
+			}
+
+			// Make the streamed data visible before this chunk is reported as done.
+			_mm_sfence();
+		}
+#endif
+
+		for (; i < End; ++i)
+		{
+			Out[i] = Generator(i);
+		}
+	}
+};
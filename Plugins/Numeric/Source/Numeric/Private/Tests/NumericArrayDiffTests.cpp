@@ -0,0 +1,182 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#include "NumericArrayDiff.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace NumericArrayDiffTests
+{
+	/** Size of a patch in int32s, counted the way Diff caps it: every hunk also stores its index and remove count. */
+	int64 PatchSize(const TArray<FNumericArrayHunk>& Hunks)
+	{
+		int64 Size = 0;
+		for (const FNumericArrayHunk& Hunk : Hunks)
+		{
+			Size += 2 + Hunk.Values.Num();
+		}
+		return Size;
+	}
+
+	TArray<int32> RandomArray(FRandomStream& Stream, int32 Num, int32 MaxValue)
+	{
+		TArray<int32> Result;
+		Result.SetNumUninitialized(Num);
+		for (int32& Value : Result)
+		{
+			Value = Stream.RandRange(0, MaxValue);
+		}
+		return Result;
+	}
+
+	/** Returns A with NumEdits short runs replaced, inserted or removed at random positions. */
+	TArray<int32> Edit(FRandomStream& Stream, const TArray<int32>& A, int32 NumEdits)
+	{
+		TArray<int32> Result = A;
+		for (int32 Edit = 0; Edit < NumEdits; ++Edit)
+		{
+			const int32 Index = Stream.RandRange(0, Result.Num());
+			const int32 Count = Stream.RandRange(1, 4);
+			switch (Stream.RandRange(0, 2))
+			{
+			case 0:
+				for (int32 i = Index; i < FMath::Min(Index + Count, Result.Num()); ++i)
+				{
+					Result[i] = Stream.RandRange(0, MAX_int32 - 1);
+				}
+				break;
+			case 1:
+				Result.Insert(RandomArray(Stream, Count, MAX_int32 - 1), Index);
+				break;
+			default:
+				Result.RemoveAt(Index, FMath::Min(Count, Result.Num() - Index));
+				break;
+			}
+		}
+		return Result;
+	}
+
+	/** Checks that Apply(Diff(A, B), A) == B and that the patch respects the whole-range cap. */
+	bool TestRoundTrip(FAutomationTestBase& Test, const TCHAR* What, const TArray<int32>& A, const TArray<int32>& B, int64& OutPatchSize)
+	{
+		const TArray<FNumericArrayHunk> Hunks = FNumericArrayDiff::Diff(A, B);
+		OutPatchSize = PatchSize(Hunks);
+
+		TArray<int32> Patched;
+		if (!FNumericArrayDiff::Apply(A, Hunks, Patched))
+		{
+			Test.AddError(FString::Printf(TEXT("%s: Apply rejected the hunks of Diff"), What));
+			return false;
+		}
+		if (Patched != B)
+		{
+			Test.AddError(FString::Printf(TEXT("%s: Apply(Diff(A, B), A) != B (%d vs %d elements)"), What, Patched.Num(), B.Num()));
+			return false;
+		}
+		if (OutPatchSize > 2 + B.Num())
+		{
+			Test.AddError(FString::Printf(TEXT("%s: patch of %lld int32s is larger than a full copy of %d"), What, OutPatchSize, B.Num()));
+			return false;
+		}
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNumericArrayDiffRoundTripTest, "Numeric.ArrayDiff.RoundTrip", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FNumericArrayDiffRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace NumericArrayDiffTests;
+
+	FRandomStream Stream(28);
+	int64 Size = 0;
+
+	// Edge cases: empty sides, identical arrays, pure insertion and pure removal.
+	const TArray<int32> Small = RandomArray(Stream, 100, 9);
+	TestRoundTrip(*this, TEXT("Empty to empty"), TArray<int32>(), TArray<int32>(), Size);
+	TestRoundTrip(*this, TEXT("Empty to array"), TArray<int32>(), Small, Size);
+	TestRoundTrip(*this, TEXT("Array to empty"), Small, TArray<int32>(), Size);
+	TestRoundTrip(*this, TEXT("Identical"), Small, Small, Size);
+	TestEqual(TEXT("Identical arrays give an empty patch"), Size, (int64)0);
+
+	// Few edits: the minimal script is found, with values drawn from a small range so runs often match by chance.
+	for (int32 Iteration = 0; Iteration < 200; ++Iteration)
+	{
+		const TArray<int32> A = RandomArray(Stream, Stream.RandRange(0, 300), 3);
+		TestRoundTrip(*this, TEXT("Minimal"), A, Edit(Stream, A, Stream.RandRange(0, 20)), Size);
+	}
+
+	// Scattered edits past MaxEditDistance: the arrays are split at unchanged blocks, which must keep the patch small.
+	for (int32 Iteration = 0; Iteration < 10; ++Iteration)
+	{
+		const TArray<int32> A = RandomArray(Stream, 64 * 1024, MAX_int32 - 1);
+		const TArray<int32> B = Edit(Stream, A, 2 * FNumericArrayDiff::MaxEditDistance);
+		if (TestRoundTrip(*this, TEXT("Anchors"), A, B, Size))
+		{
+			TestTrue(TEXT("Anchored patch is a small fraction of a full copy"), Size < B.Num() / 4);
+		}
+	}
+
+	// Repetitive data: blocks occur many times, so they are not used as anchors.
+	for (int32 Iteration = 0; Iteration < 5; ++Iteration)
+	{
+		TArray<int32> A;
+		for (int32 i = 0; i < 32 * 1024; ++i)
+		{
+			A.Add(i % 48);
+		}
+		TestRoundTrip(*this, TEXT("Repetitive"), A, Edit(Stream, A, 2 * FNumericArrayDiff::MaxEditDistance), Size);
+	}
+
+	// Unrelated arrays: the patch falls back to a single hunk replacing the changed range.
+	for (int32 Iteration = 0; Iteration < 5; ++Iteration)
+	{
+		const TArray<int32> A = RandomArray(Stream, 16 * 1024, MAX_int32 - 1);
+		const TArray<int32> B = RandomArray(Stream, Stream.RandRange(8 * 1024, 24 * 1024), MAX_int32 - 1);
+		if (TestRoundTrip(*this, TEXT("Unrelated"), A, B, Size))
+		{
+			TestEqual(TEXT("Unrelated arrays are replaced in one hunk"), Size, (int64)(2 + B.Num()));
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNumericArrayDiffBenchmark, "Numeric.ArrayDiff.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FNumericArrayDiffBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace NumericArrayDiffTests;
+
+	FRandomStream Stream(28);
+	const TArray<int32> A = RandomArray(Stream, 1024 * 1024, MAX_int32 - 1);
+
+	// From a handful of edits, which the minimal script covers, to enough that the arrays are split at anchors.
+	for (const int32 NumEdits : { 16, 256, 4096 })
+	{
+		const TArray<int32> B = Edit(Stream, A, NumEdits);
+
+		double Start = FPlatformTime::Seconds();
+		const TArray<FNumericArrayHunk> Hunks = FNumericArrayDiff::Diff(A, B);
+		const double DiffSeconds = FPlatformTime::Seconds() - Start;
+
+		TArray<int32> Patched;
+		Start = FPlatformTime::Seconds();
+		FNumericArrayDiff::Apply(A, Hunks, Patched);
+		const double ApplySeconds = FPlatformTime::Seconds() - Start;
+
+		Start = FPlatformTime::Seconds();
+		const TArray<int32> Copy = B;
+		const double CopySeconds = FPlatformTime::Seconds() - Start;
+
+		TestTrue(TEXT("Patched array matches"), Patched == B && Copy == B);
+		AddInfo(FString::Printf(TEXT("%d edits: patch of %d hunks, %lld bytes against %lld for a full copy; diff %.2f ms, apply %.2f ms, full copy %.2f ms"),
+			NumEdits, Hunks.Num(), PatchSize(Hunks) * (int64)sizeof(int32), (int64)B.Num() * (int64)sizeof(int32),
+			DiffSeconds * 1000.0, ApplySeconds * 1000.0, CopySeconds * 1000.0));
+	}
+
+	return true;
+}
+
+#endif
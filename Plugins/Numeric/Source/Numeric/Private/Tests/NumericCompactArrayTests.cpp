@@ -0,0 +1,125 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#include "NumericCompactArray.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace NumericCompactArrayTests
+{
+	/** 128 sevens, 128 elements cycling through -2..1, then -1, 300, -70000, MAX_int32 and MIN_int32. */
+	TArray<int32> MakeGoldenArray()
+	{
+		TArray<int32> Result;
+		for (int32 i = 0; i < 128; ++i)
+		{
+			Result.Add(7);
+		}
+		for (int32 i = 0; i < 128; ++i)
+		{
+			Result.Add(i % 4 - 2);
+		}
+		Result.Append({ -1, 300, -70000, MAX_int32, MIN_int32 });
+		return Result;
+	}
+
+	/** The golden array as written by version 1, whose full bit-packed blocks were packed sequentially. */
+	const uint8 GoldenVersion1[] = {
+		0x01, 0x85, 0x02, 0x04, 0x0E, 0x00, 0x04, 0x03, 0x02, 0xE4, 0xE4, 0xE4, 0xE4, 0xE4, 0xE4, 0xE4,
+		0xE4, 0xE4, 0xE4, 0xE4, 0xE4, 0xE4, 0xE4, 0xE4, 0xE4, 0xE4, 0xE4, 0xE4, 0xE4, 0xE4, 0xE4, 0xE4,
+		0xE4, 0xE4, 0xE4, 0xE4, 0xE4, 0xE4, 0xE4, 0xE4, 0xE4, 0x02, 0x01, 0xDA, 0x04, 0xB7, 0xCA, 0x08,
+		0xA1, 0xBA, 0xF7, 0xFF, 0x0F, 0x02,
+	};
+
+	/** The golden array as written by version 2, with the second block in four interleaved lanes. */
+	const uint8 GoldenVersion2[] = {
+		0x02, 0x85, 0x02, 0x05, 0x0E, 0x00, 0x05, 0x03, 0x02, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55,
+		0x55, 0xAA, 0xAA, 0xAA, 0xAA, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55,
+		0x55, 0xAA, 0xAA, 0xAA, 0xAA, 0xFF, 0xFF, 0xFF, 0xFF, 0x02, 0x01, 0xDA, 0x04, 0xB7, 0xCA, 0x08,
+		0xA1, 0xBA, 0xF7, 0xFF, 0x0F, 0x02,
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNumericCompactArrayRoundTripTest, "Numeric.CompactArray.RoundTrip", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FNumericCompactArrayRoundTripTest::RunTest(const FString& Parameters)
+{
+	FRandomStream Stream(27);
+	constexpr int32 BlockNum = FNumericCompactArray::BlockNum;
+
+	// Lengths around block boundaries, so full and partial blocks of every encoding are exercised.
+	for (const int32 Num : { 0, 1, BlockNum - 1, BlockNum, BlockNum + 1, 5 * BlockNum + 3 })
+	{
+		// Each shape favours a different encoding: raw, delta, varint, run-length and bit-packed of every width.
+		for (int32 Shape = 0; Shape < 5 + 33; ++Shape)
+		{
+			TArray<int32> A;
+			int32 Current = Stream.RandRange(-1000, 1000);
+			for (int32 i = 0; i < Num; ++i)
+			{
+				switch (Shape)
+				{
+				case 0: A.Add((int32)Stream.GetUnsignedInt()); break;
+				case 1: A.Add(Current += Stream.RandRange(0, 4)); break;
+				case 2: A.Add(Stream.RandRange(-3, 3)); break;
+				case 3: A.Add(Stream.RandRange(0, 9) == 0 ? (Current = (int32)Stream.GetUnsignedInt()) : Current); break;
+				case 4: A.Add(Stream.RandRange(0, 1) ? MAX_int32 : MIN_int32); break;
+				default:
+				{
+					const int32 Bits = Shape - 5;
+					const uint32 Mask = Bits == 32 ? ~0u : (1u << Bits) - 1;
+					A.Add((int32)(Stream.GetUnsignedInt() & Mask) - 77);
+					break;
+				}
+				}
+			}
+
+			TArray<uint8> Encoded;
+			FNumericCompactArray::Encode(A, Encoded);
+
+			TArray<int32> Decoded;
+			if (!FNumericCompactArray::Decode(Encoded, Decoded) || Decoded != A)
+			{
+				AddError(FString::Printf(TEXT("Round trip failed for shape %d and %d elements"), Shape, Num));
+				continue;
+			}
+
+			// A truncated buffer must be rejected rather than decoded short.
+			if (Num > 0 && FNumericCompactArray::Decode(MakeArrayView(Encoded.GetData(), Encoded.Num() - 1), Decoded))
+			{
+				AddError(FString::Printf(TEXT("Truncated buffer decoded for shape %d and %d elements"), Shape, Num));
+			}
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNumericCompactArrayFormatTest, "Numeric.CompactArray.Format", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FNumericCompactArrayFormatTest::RunTest(const FString& Parameters)
+{
+	using namespace NumericCompactArrayTests;
+
+	const TArray<int32> Golden = MakeGoldenArray();
+
+	// The encoded bytes are part of the format: they must not change, and must not depend on the platform.
+	TArray<uint8> Encoded;
+	FNumericCompactArray::Encode(Golden, Encoded);
+	TestTrue(TEXT("Encode writes the version 2 golden bytes"), Encoded == TArray<uint8>(GoldenVersion2, UE_ARRAY_COUNT(GoldenVersion2)));
+
+	TArray<int32> Decoded;
+	TestTrue(TEXT("Version 2 golden buffer decodes"), FNumericCompactArray::Decode(MakeArrayView(GoldenVersion2, UE_ARRAY_COUNT(GoldenVersion2)), Decoded) && Decoded == Golden);
+	TestTrue(TEXT("Version 1 golden buffer decodes"), FNumericCompactArray::Decode(MakeArrayView(GoldenVersion1, UE_ARRAY_COUNT(GoldenVersion1)), Decoded) && Decoded == Golden);
+
+	// Buffers from a newer format version, and empty buffers, are rejected.
+	TArray<uint8> Newer(GoldenVersion2, UE_ARRAY_COUNT(GoldenVersion2));
+	Newer[0] = FNumericCompactArray::Version + 1;
+	TestFalse(TEXT("Newer version is rejected"), FNumericCompactArray::Decode(Newer, Decoded));
+	TestFalse(TEXT("Empty buffer is rejected"), FNumericCompactArray::Decode(TArrayView<const uint8>(), Decoded));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,111 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#include "NumericDispatch.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ConfigCacheIni.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNumericDispatchProfileTest, "Numeric.Dispatch.Profile", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FNumericDispatchProfileTest::RunTest(const FString& Parameters)
+{
+	if (!GConfig)
+	{
+		AddError(TEXT("GConfig is not available"));
+		return false;
+	}
+
+	constexpr int32 NumThresholds = (int32)ENumericThreshold::Count;
+	const TCHAR* const ProfileSection = TEXT("Numeric.DispatchProfile");
+
+	// The profile lives in the saved engine config, so whatever is there is put back afterwards, with the table.
+	TArray<const TCHAR*> Keys = { TEXT("HostId") };
+	int32 PreviousThresholds[NumThresholds];
+	for (int32 i = 0; i < NumThresholds; ++i)
+	{
+		Keys.Add(FNumericDispatch::GetName((ENumericThreshold)i));
+		PreviousThresholds[i] = FNumericDispatch::Get((ENumericThreshold)i);
+	}
+	TArray<FString> PreviousValues;
+	TArray<bool> HadKey;
+	for (const TCHAR* Key : Keys)
+	{
+		FString Value;
+		HadKey.Add(GConfig->GetString(ProfileSection, Key, Value, GEngineIni));
+		PreviousValues.Add(Value);
+	}
+
+	// With nothing measured, saving writes this host's id and no thresholds.
+	FNumericDispatch::ResetToDefaults();
+	FNumericDispatch::SaveProfile();
+	TestFalse(TEXT("Nothing measured is not a complete profile"), FNumericDispatch::LoadProfile());
+
+	auto ProfileValue = [ProfileSection](ENumericThreshold Threshold)
+	{
+		int32 Value = INDEX_NONE;
+		GConfig->GetInt(ProfileSection, FNumericDispatch::GetName(Threshold), Value, GEngineIni);
+		return Value;
+	};
+
+	// A complete profile loads every threshold.
+	for (int32 i = 0; i < NumThresholds; ++i)
+	{
+		GConfig->SetInt(ProfileSection, FNumericDispatch::GetName((ENumericThreshold)i), 1000 + i, GEngineIni);
+	}
+	TestTrue(TEXT("Complete profile loads"), FNumericDispatch::LoadProfile());
+	for (int32 i = 0; i < NumThresholds; ++i)
+	{
+		TestEqual(FString::Printf(TEXT("Loaded %s"), FNumericDispatch::GetName((ENumericThreshold)i)), FNumericDispatch::Get((ENumericThreshold)i), 1000 + i);
+	}
+
+	// Loaded thresholds count as measured, so saving writes them back; console overrides are not cached.
+	for (int32 i = 0; i < NumThresholds; ++i)
+	{
+		GConfig->RemoveKey(ProfileSection, FNumericDispatch::GetName((ENumericThreshold)i), GEngineIni);
+	}
+	FNumericDispatch::Set(ENumericThreshold::RadixSort, 777);
+	FNumericDispatch::SaveProfile();
+	for (int32 i = 0; i < NumThresholds; ++i)
+	{
+		TestEqual(FString::Printf(TEXT("Saved %s"), FNumericDispatch::GetName((ENumericThreshold)i)), ProfileValue((ENumericThreshold)i), 1000 + i);
+	}
+
+	// StreamingStore is never measured, so a profile without it is still complete; any other gap is not.
+	GConfig->RemoveKey(ProfileSection, FNumericDispatch::GetName(ENumericThreshold::StreamingStore), GEngineIni);
+	TestTrue(TEXT("Profile without StreamingStore is complete"), FNumericDispatch::LoadProfile());
+	GConfig->RemoveKey(ProfileSection, FNumericDispatch::GetName(ENumericThreshold::RadixSortValues), GEngineIni);
+	TestFalse(TEXT("Profile without RadixSortValues is incomplete"), FNumericDispatch::LoadProfile());
+
+	// A profile measured on another host is ignored entirely.
+	GConfig->SetInt(ProfileSection, FNumericDispatch::GetName(ENumericThreshold::RadixSortValues), 1000 + (int32)ENumericThreshold::RadixSortValues, GEngineIni);
+	GConfig->SetString(ProfileSection, TEXT("HostId"), TEXT("Another host"), GEngineIni);
+	FNumericDispatch::ResetToDefaults();
+	const int32 DefaultRadixSort = FNumericDispatch::Get(ENumericThreshold::RadixSort);
+	TestFalse(TEXT("Profile of another host does not load"), FNumericDispatch::LoadProfile());
+	TestEqual(TEXT("Profile of another host leaves the table alone"), FNumericDispatch::Get(ENumericThreshold::RadixSort), DefaultRadixSort);
+
+	// Restore the config, the measurements it holds and any overrides of the table.
+	for (int32 i = 0; i < Keys.Num(); ++i)
+	{
+		if (HadKey[i])
+		{
+			GConfig->SetString(ProfileSection, Keys[i], *PreviousValues[i], GEngineIni);
+		}
+		else
+		{
+			GConfig->RemoveKey(ProfileSection, Keys[i], GEngineIni);
+		}
+	}
+	GConfig->Flush(false, GEngineIni);
+	FNumericDispatch::ResetToDefaults();
+	FNumericDispatch::LoadProfile();
+	for (int32 i = 0; i < NumThresholds; ++i)
+	{
+		FNumericDispatch::Set((ENumericThreshold)i, PreviousThresholds[i]);
+	}
+
+	return true;
+}
+
+#endif
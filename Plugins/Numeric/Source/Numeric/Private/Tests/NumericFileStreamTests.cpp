@@ -0,0 +1,85 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#include "NumericFileStream.h"
+#include "NumericBPLibrary.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNumericFileStreamTest, "Numeric.FileStream", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FNumericFileStreamTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 ChunkNum = 1000;
+
+	// A length that is not a multiple of the chunk size, so the last chunk is partial.
+	TArray<int32> Values;
+	for (int32 i = 0; i < 10 * ChunkNum + 7; ++i)
+	{
+		Values.Add(i * 3 - 5000);
+	}
+
+	const FString Path = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("NumericFileStream.bin"));
+	if (!FFileHelper::SaveArrayToFile(MakeArrayView(reinterpret_cast<const uint8*>(Values.GetData()), Values.Num() * sizeof(int32)), *Path))
+	{
+		AddError(FString::Printf(TEXT("Could not write %s"), *Path));
+		return false;
+	}
+
+	const FNumericFileStream Stream(Path, ChunkNum);
+	TestTrue(TEXT("Stream is valid"), Stream.IsValid());
+	TestEqual(TEXT("Num"), Stream.Num(), (int64)Values.Num());
+
+	// Every window must hold the file's elements at its FirstIndex, start Overlap elements before the end of the
+	// previous window, and together the windows must cover the file once.
+	for (const int32 Overlap : { 0, 3, ChunkNum - 1, 2 * ChunkNum + 1 })
+	{
+		int64 End = 0;
+		bool bContentMatches = true;
+		bool bWindowsMatch = true;
+		const bool bRead = Stream.ForEachChunk([&](const int32* Data, int32 Num, int64 FirstIndex)
+		{
+			bWindowsMatch &= FirstIndex == FMath::Max<int64>(End - Overlap, 0) && FirstIndex + Num == FMath::Min<int64>(End + ChunkNum, Values.Num());
+			bContentMatches &= FMemory::Memcmp(Data, Values.GetData() + FirstIndex, Num * sizeof(int32)) == 0;
+			End = FirstIndex + Num;
+			return true;
+		}, Overlap);
+
+		TestTrue(FString::Printf(TEXT("Overlap %d: file read"), Overlap), bRead);
+		TestTrue(FString::Printf(TEXT("Overlap %d: windows start Overlap elements back"), Overlap), bWindowsMatch);
+		TestTrue(FString::Printf(TEXT("Overlap %d: windows hold the file's elements"), Overlap), bContentMatches);
+		TestEqual(FString::Printf(TEXT("Overlap %d: windows cover the file"), Overlap), End, (int64)Values.Num());
+	}
+
+	int32 NumVisits = 0;
+	TestTrue(TEXT("Stopping early is not a failure"), Stream.ForEachChunk([&NumVisits](const int32* Data, int32 Num, int64 FirstIndex) { return ++NumVisits < 2; }));
+	TestEqual(TEXT("Visitor is not called after returning false"), NumVisits, 2);
+
+	// The library's file nodes agree with their in-memory counterparts.
+	bool Success = false;
+	int64 Sum = 0;
+	for (const int32 Value : Values)
+	{
+		Sum += Value;
+	}
+	TestEqual(TEXT("FileAccumulate"), UNumericBPLibrary::FileAccumulate(Path, Success), Sum);
+	TestTrue(TEXT("FileAccumulate succeeds"), Success);
+	TestTrue(TEXT("FileIsSorted"), UNumericBPLibrary::FileIsSorted(Path, Success) && Success);
+	TestEqual(TEXT("FileArrayMax"), UNumericBPLibrary::FileArrayMax(Path, Success), Values.Last());
+
+	// A size that is not a whole number of int32 elements is rejected, as is a missing file.
+	const uint8 Partial[] = { 1, 2, 3, 4, 5, 6, 7 };
+	FFileHelper::SaveArrayToFile(MakeArrayView(Partial, UE_ARRAY_COUNT(Partial)), *Path);
+	TestFalse(TEXT("Partial element is rejected"), FNumericFileStream(Path, ChunkNum).IsValid());
+	TestFalse(TEXT("Partial element is not read"), FNumericFileStream(Path, ChunkNum).ForEachChunk([](const int32* Data, int32 Num, int64 FirstIndex) { return true; }));
+
+	IFileManager::Get().Delete(*Path);
+	TestFalse(TEXT("Missing file is rejected"), FNumericFileStream(Path, ChunkNum).IsValid());
+
+	return true;
+}
+
+#endif
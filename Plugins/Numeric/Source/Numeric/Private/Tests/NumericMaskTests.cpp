@@ -0,0 +1,89 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#include "NumericMask.h"
+#include "NumericSort.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace NumericMaskTests
+{
+	/** Returns true if every bit matches Expected and the bits past Num in the last word are zero. */
+	bool MatchesBools(const FNumericMask& Mask, const TArray<bool>& Expected)
+	{
+		if (Mask.Num() != Expected.Num() || Mask.GetWords().Num() != FMath::DivideAndRoundUp(Expected.Num(), FNumericMask::BitsPerWord))
+		{
+			return false;
+		}
+		for (int32 i = 0; i < Expected.Num(); ++i)
+		{
+			if (Mask.Get(i) != Expected[i])
+			{
+				return false;
+			}
+		}
+		const int32 TailBits = Expected.Num() % FNumericMask::BitsPerWord;
+		return TailBits == 0 || (Mask.GetWords().Last() >> TailBits) == 0;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNumericMaskTest, "Numeric.Mask", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FNumericMaskTest::RunTest(const FString& Parameters)
+{
+	using namespace NumericMaskTests;
+
+	FRandomStream Stream(38);
+
+	// Lengths around word boundaries, and one large enough to be built on worker threads.
+	for (const int32 Num : { 0, 1, 31, 32, 33, 1000, 256 * 1024 + 5 })
+	{
+		TArray<int32> A;
+		for (int32 i = 0; i < Num; ++i)
+		{
+			A.Add(Stream.RandRange(-50, 50));
+		}
+
+		const FNumericMask Positive = FNumericMask::FromPredicate(A, [](int32 Value) { return Value > 0; });
+		const FNumericMask Even = FNumericMask::FromPredicate(A, [](int32 Value) { return Value % 2 == 0; });
+
+		TArray<bool> IsPositive, IsEven, IsBoth, IsEither, IsNotPositive;
+		TArray<int32> Selected, SelectedIndices;
+		for (int32 i = 0; i < Num; ++i)
+		{
+			IsPositive.Add(A[i] > 0);
+			IsEven.Add(A[i] % 2 == 0);
+			IsBoth.Add(IsPositive[i] && IsEven[i]);
+			IsEither.Add(IsPositive[i] || IsEven[i]);
+			IsNotPositive.Add(!IsPositive[i]);
+			if (IsBoth[i])
+			{
+				Selected.Add(A[i]);
+				SelectedIndices.Add(i);
+			}
+		}
+
+		const FString Prefix = FString::Printf(TEXT("%d elements: "), Num);
+		TestTrue(Prefix + TEXT("FromPredicate"), MatchesBools(Positive, IsPositive) && MatchesBools(Even, IsEven));
+
+		const FNumericMask Both = Positive & Even;
+		TestTrue(Prefix + TEXT("operator&"), MatchesBools(Both, IsBoth));
+		TestTrue(Prefix + TEXT("operator|"), MatchesBools(Positive | Even, IsEither));
+		TestTrue(Prefix + TEXT("operator~ keeps the bits past Num clear"), MatchesBools(~Positive, IsNotPositive));
+		TestEqual(Prefix + TEXT("CountSetBits"), Both.CountSetBits(), Selected.Num());
+
+		// Select, and Gather over the set indices, both give the filtered elements in order.
+		TestTrue(Prefix + TEXT("Select"), Both.Select(A) == Selected);
+		const TArray<int32> Indices = Both.Indices();
+		TestTrue(Prefix + TEXT("Indices"), Indices == SelectedIndices);
+		TestTrue(Prefix + TEXT("Gather(A, Indices) == Select(A)"), FNumericSort::Gather<int32>(A, Indices) == Selected);
+
+		TestEqual(Prefix + TEXT("All set"), FNumericMask(Num, true).CountSetBits(), Num);
+		TestEqual(Prefix + TEXT("All set, inverted"), (~FNumericMask(Num, true)).CountSetBits(), 0);
+	}
+
+	return true;
+}
+
+#endif
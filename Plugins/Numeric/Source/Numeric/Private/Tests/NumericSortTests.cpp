@@ -0,0 +1,152 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#include "NumericSort.h"
+#include "Algo/Sort.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace NumericSortTests
+{
+	/** Keys of several shapes: full-range random, few distinct values (many ties), already sorted and reversed. */
+	TArray<int32> MakeKeys(FRandomStream& Stream, int32 Num, int32 Shape)
+	{
+		TArray<int32> Keys;
+		Keys.SetNumUninitialized(Num);
+		for (int32 i = 0; i < Num; ++i)
+		{
+			switch (Shape)
+			{
+			case 0: Keys[i] = (int32)Stream.GetUnsignedInt(); break;
+			case 1: Keys[i] = Stream.RandRange(-4, 4); break;
+			case 2: Keys[i] = i - Num / 2; break;
+			default: Keys[i] = Num - i; break;
+			}
+		}
+		return Keys;
+	}
+
+	/** Returns true if Order is a permutation that sorts Keys ascending, with equal keys in their original order. */
+	bool IsStableOrder(const TArray<int32>& Keys, const TArray<int32>& Order)
+	{
+		if (Order.Num() != Keys.Num() || !FNumericSort::IsPermutation(Order))
+		{
+			return false;
+		}
+		for (int32 i = 1; i < Order.Num(); ++i)
+		{
+			const int32 Previous = Keys[Order[i - 1]];
+			const int32 Current = Keys[Order[i]];
+			if (Previous > Current || (Previous == Current && Order[i - 1] > Order[i]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNumericSortTest, "Numeric.Sort", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FNumericSortTest::RunTest(const FString& Parameters)
+{
+	using namespace NumericSortTests;
+
+	FRandomStream Stream(31);
+
+	// Every path is forced in turn, so the test does not depend on the dispatch table's thresholds.
+	for (const int32 Num : { 0, 1, 100, 5000, 100 * 1000 })
+	{
+		for (int32 Shape = 0; Shape < 4; ++Shape)
+		{
+			const TArray<int32> Keys = MakeKeys(Stream, Num, Shape);
+
+			TArray<int32> Ascending = Keys;
+			Algo::Sort(Ascending);
+			TArray<int32> Descending = Keys;
+			Algo::Sort(Descending, TGreater<int32>());
+
+			for (const bool bRadix : { false, true })
+			{
+				for (const int32 NumChunks : { 1, 4 })
+				{
+					const FString Path = FString::Printf(TEXT("%d keys of shape %d, %s sort in %d chunks"), Num, Shape, bRadix ? TEXT("radix") : TEXT("comparison"), NumChunks);
+
+					TestTrue(Path + TEXT(": ArgSort is stable"), IsStableOrder(Keys, FNumericSort::ArgSort(Keys, bRadix, NumChunks)));
+
+					TArray<int32> Sorted = Keys;
+					FNumericSort::Sort(Sorted, false, bRadix, NumChunks);
+					TestTrue(Path + TEXT(": Sort ascending"), Sorted == Ascending);
+
+					Sorted = Keys;
+					FNumericSort::Sort(Sorted, true, bRadix, NumChunks);
+					TestTrue(Path + TEXT(": Sort descending"), Sorted == Descending);
+				}
+			}
+
+			TestTrue(TEXT("ArgSort through the dispatch table is stable"), IsStableOrder(Keys, FNumericSort::ArgSort(Keys)));
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNumericGatherScatterTest, "Numeric.Sort.GatherScatter", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FNumericGatherScatterTest::RunTest(const FString& Parameters)
+{
+	using namespace NumericSortTests;
+
+	FRandomStream Stream(31);
+
+	for (const int32 Num : { 0, 1, 1000, 100 * 1000 })
+	{
+		const TArray<int32> Values = MakeKeys(Stream, Num, 0);
+
+		// A random permutation, so Gather and Scatter are each other's inverse.
+		TArray<int32> Permutation;
+		for (int32 i = 0; i < Num; ++i)
+		{
+			Permutation.Add(i);
+		}
+		for (int32 i = Num - 1; i > 0; --i)
+		{
+			Permutation.Swap(i, Stream.RandRange(0, i));
+		}
+		TestTrue(TEXT("Shuffled indices are a permutation"), FNumericSort::IsPermutation(Permutation));
+
+		const TArray<int32> Gathered = FNumericSort::Gather<int32>(Values, Permutation);
+		const TArray<int32> Scattered = FNumericSort::Scatter<int32>(Values, Permutation);
+		TestTrue(FString::Printf(TEXT("%d elements: Scatter(Gather(A, P), P) == A"), Num), FNumericSort::Scatter<int32>(Gathered, Permutation) == Values);
+		TestTrue(FString::Printf(TEXT("%d elements: Gather(Scatter(A, P), P) == A"), Num), FNumericSort::Gather<int32>(Scattered, Permutation) == Values);
+
+		// SortByKey moves every payload with its key.
+		TArray<int32> Keys = MakeKeys(Stream, Num, 1);
+		TArray<int32> Indices = Permutation;
+		TArray<double> Doubles;
+		for (const int32 Index : Indices)
+		{
+			Doubles.Add(Index * 0.5);
+		}
+		const TArray<int32> Order = FNumericSort::ArgSort(Keys);
+		const TArray<int32> OriginalKeys = Keys;
+		FNumericSort::SortByKey(Keys, Indices, Doubles);
+
+		bool bPayloadsFollow = true;
+		for (int32 i = 0; i < Num; ++i)
+		{
+			bPayloadsFollow &= Keys[i] == OriginalKeys[Order[i]] && Indices[i] == Permutation[Order[i]] && Doubles[i] == Permutation[Order[i]] * 0.5;
+		}
+		TestTrue(FString::Printf(TEXT("%d elements: SortByKey permutes payloads with their keys"), Num), bPayloadsFollow);
+	}
+
+	// Duplicates and out-of-range indices are not permutations.
+	TestFalse(TEXT("Duplicate index"), FNumericSort::IsPermutation(TArray<int32>({ 0, 1, 1 })));
+	TestFalse(TEXT("Index past the end"), FNumericSort::IsPermutation(TArray<int32>({ 0, 3, 1 })));
+	TestFalse(TEXT("Negative index"), FNumericSort::IsPermutation(TArray<int32>({ 0, -1, 1 })));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,100 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#include "NumericStatic.h"
+#include "Misc/AutomationTest.h"
+
+// The kernels are meant to run at compile time, so they are checked at compile time: a kernel that stops being
+// constexpr, or a sorting network that stops sorting, fails the build rather than a test run.
+namespace NumericStaticTests
+{
+	template <uint32 N>
+	constexpr TStaticArray<int32, N> MakeStatic(const int32 (&Values)[N])
+	{
+		TStaticArray<int32, N> Result;
+		for (uint32 i = 0; i < N; ++i)
+		{
+			Result[i] = Values[i];
+		}
+		return Result;
+	}
+
+	template <typename ArrayType, SIZE_T N>
+	constexpr bool Equals(const ArrayType& A, const int32 (&Expected)[N])
+	{
+		for (SIZE_T i = 0; i < N; ++i)
+		{
+			if (A[i] != Expected[i])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	constexpr int32 Unsorted[] = { 5, -3, 9, 0, 9, -7, 2 };
+
+	static_assert(Equals(FNumericStatic::Iota<4>(-1), { -1, 0, 1, 2 }));
+	static_assert(Equals(FNumericStatic::Fill<3>(7), { 7, 7, 7 }));
+	static_assert(Equals(FNumericStatic::PartialSum(FNumericStatic::Iota<8>(1)), { 1, 3, 6, 10, 15, 21, 28, 36 }));
+	static_assert(Equals(FNumericStatic::SortAscending(std::to_array(Unsorted)), { -7, -3, 0, 2, 5, 9, 9 }));
+	static_assert(Equals(FNumericStatic::SortDescending(std::to_array(Unsorted)), { 9, 9, 5, 2, 0, -3, -7 }));
+	static_assert(FNumericStatic::ArrayMax(std::to_array(Unsorted)) == 9);
+	static_assert(FNumericStatic::ArrayMin(std::to_array(Unsorted)) == -7);
+	static_assert(FNumericStatic::Accumulate(std::to_array(Unsorted)) == 15);
+
+	static_assert(Equals(FNumericStatic::SortAscending(MakeStatic(Unsorted)), { -7, -3, 0, 2, 5, 9, 9 }));
+	static_assert(Equals(FNumericStatic::SortDescending(MakeStatic(Unsorted)), { 9, 9, 5, 2, 0, -3, -7 }));
+	static_assert(FNumericStatic::ArrayMax(MakeStatic(Unsorted)) == 9);
+	static_assert(FNumericStatic::ArrayMin(MakeStatic(Unsorted)) == -7);
+	static_assert(FNumericStatic::Accumulate(MakeStatic(Unsorted)) == 15);
+	static_assert(Equals(FNumericStatic::PartialSum(MakeStatic(Unsorted)), { 5, 2, 11, 11, 20, 13, 15 }));
+
+	constexpr TStaticArray<int32, 5> StaticIota = []
+	{
+		TStaticArray<int32, 5> A;
+		FNumericStatic::Iota(A, 10);
+		return A;
+	}();
+	static_assert(Equals(StaticIota, { 10, 11, 12, 13, 14 }));
+
+	constexpr TStaticArray<int32, 3> StaticFill = []
+	{
+		TStaticArray<int32, 3> A;
+		FNumericStatic::Fill(A, -2);
+		return A;
+	}();
+	static_assert(Equals(StaticFill, { -2, -2, -2 }));
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNumericStaticSortTest, "Numeric.Static.Sort", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FNumericStaticSortTest::RunTest(const FString& Parameters)
+{
+	// The sorting network is exhaustively checked against every 0/1 input, which by the 0-1 principle covers all inputs.
+	constexpr uint32 N = 10;
+	for (uint32 Bits = 0; Bits < (1u << N); ++Bits)
+	{
+		TStaticArray<int32, N> A;
+		for (uint32 i = 0; i < N; ++i)
+		{
+			A[i] = (Bits >> i) & 1;
+		}
+
+		const TStaticArray<int32, N> Sorted = FNumericStatic::SortAscending(A);
+		for (uint32 i = 1; i < N; ++i)
+		{
+			if (Sorted[i - 1] > Sorted[i])
+			{
+				AddError(FString::Printf(TEXT("SortAscending left input %u unsorted"), Bits));
+				return false;
+			}
+		}
+		TestEqual(TEXT("Accumulate"), FNumericStatic::Accumulate(Sorted), (int32)FMath::CountBits(Bits));
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,72 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+/**
+ * Append-only int32 buffer that many threads can push to at once.
+ *
+ * Samples go to per-thread shards. Each buffer hands out its shards in the order threads first push to it, so the first
+ * NumShards producers of a buffer each get a shard of their own and never contend; further producers share shards
+ * round-robin. Threads remember their shard for the last few buffers they pushed to only, so a thread that alternates
+ * between more buffers than that may be handed a different shard when it returns to one. Each shard also keeps a running count, sum, minimum and maximum, so those can be read without
+ * concatenating the shards, or without storing samples at all.
+ */
+class NUMERIC_API FNumericAppendBuffer
+{
+public:
+	/** Aggregates of every sample pushed since the last Drain or Reset. Min and Max are 0 when Num is 0. */
+	struct FStats
+	{
+		int64 Num = 0;
+		int64 Sum = 0;
+		int32 Min = 0;
+		int32 Max = 0;
+	};
+
+	/**
+	 * @param bInStoreSamples If false, only the running aggregates are kept and Snapshot and Drain return empty arrays.
+	 * @param NumShards Number of shards, i.e. of producer threads that can push without contention. Defaults to one per logical core.
+	 */
+	explicit FNumericAppendBuffer(bool bInStoreSamples = true, int32 NumShards = 0);
+	~FNumericAppendBuffer();
+
+	FNumericAppendBuffer(const FNumericAppendBuffer&) = delete;
+	FNumericAppendBuffer& operator=(const FNumericAppendBuffer&) = delete;
+
+	/** Adds a sample. Safe to call from any thread. */
+	void Push(int32 Value);
+
+	/** Adds several samples, keeping them contiguous. Safe to call from any thread. */
+	void Append(TArrayView<const int32> Values);
+
+	/** Returns a contiguous copy of every stored sample, shard by shard. Order between threads is unspecified. */
+	TArray<int32> Snapshot() const;
+
+	/** Moves every stored sample into one contiguous array and empties the buffer, ready to be fed to the library's kernels. */
+	TArray<int32> Drain();
+
+	/** Merges the running aggregates of all shards. */
+	FStats Reduce() const;
+
+	/** Empties the buffer. */
+	void Reset();
+
+private:
+	struct FShard;
+
+	FShard& GetThreadShard();
+
+	TUniquePtr<FShard[]> Shards;
+	int32 NumShards;
+	bool bStoreSamples;
+
+	/** Identifies this buffer in the threads' shard caches. Never reused, unlike the buffer's address. */
+	uint64 Id;
+
+	/** Shard given to the next thread that pushes to this buffer for the first time, modulo NumShards. */
+	std::atomic<uint32> NextShard{ 0 };
+};
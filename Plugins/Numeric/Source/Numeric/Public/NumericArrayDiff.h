@@ -0,0 +1,48 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NumericArrayDiff.generated.h"
+
+/** One edit of a patch: removes RemoveCount elements of the source array at Index and inserts Values in their place. */
+USTRUCT(BlueprintType)
+struct NUMERIC_API FNumericArrayHunk
+{
+	GENERATED_BODY()
+
+	/** Index in the source array where the edit starts. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Array Utils")
+	int32 Index = 0;
+
+	/** Number of source elements removed. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Array Utils")
+	int32 RemoveCount = 0;
+
+	/** Elements inserted in place of the removed ones. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Array Utils")
+	TArray<int32> Values;
+};
+
+/** Computes and applies compact edit scripts between int32 arrays. */
+struct NUMERIC_API FNumericArrayDiff
+{
+	/** Edit distance above which the diff stops searching for the minimal script and splits the arrays at unchanged blocks instead. */
+	static constexpr int32 MaxEditDistance = 512;
+
+	/**
+	 * Returns the hunks that turn A into B, sorted by Index and non-overlapping.
+	 * Common prefixes and suffixes are skipped block-wise; the remainder uses Myers' O(ND) diff so inserted or removed
+	 * elements do not turn the rest of the array into changes. When that search runs out of budget, unchanged blocks are
+	 * matched by hash and the gaps between them are diffed separately. The hunks never hold more data than a single hunk
+	 * replacing the whole changed range would.
+	 */
+	static TArray<FNumericArrayHunk> Diff(TArrayView<const int32> A, TArrayView<const int32> B);
+
+	/**
+	 * Applies hunks produced by Diff to A.
+	 *
+	 * @return false if the hunks are out of order, overlap, or fall outside A. Out is left empty in that case.
+	 */
+	static bool Apply(TArrayView<const int32> A, TArrayView<const FNumericArrayHunk> Hunks, TArray<int32>& Out);
+};
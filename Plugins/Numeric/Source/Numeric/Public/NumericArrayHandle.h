@@ -0,0 +1,55 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NumericArrayHandle.generated.h"
+
+/**
+ * Reference-counted, copy-on-write handle to an int32 array.
+ *
+ * Copying a handle, as Blueprints do at every node, only bumps a reference count. Slices share the storage of the array
+ * they were taken from, and the elements are copied only when a handle whose storage is shared is modified.
+ * Handles are transient: they are not saved with the object that holds them.
+ *
+ * The library's handle nodes cover queries (length, element access, min/max, sum, count, equality, inner product,
+ * sorted searches), views (take, slice, biggest/smallest) and in-place edits (set, sort, fill, replace, clamp, rotate),
+ * i.e. the operations whose TArray versions copy an input they do not need to. Nodes that build a new array of another
+ * length or content, such as PartialSum, Unique or Gather, allocate their result anyway and have no handle version;
+ * use To Array to feed them.
+ */
+USTRUCT(BlueprintType)
+struct NUMERIC_API FNumericArrayHandle
+{
+	GENERATED_BODY()
+
+	FNumericArrayHandle() = default;
+	explicit FNumericArrayHandle(const TArray<int32>& InArray);
+	explicit FNumericArrayHandle(TArray<int32>&& InArray);
+
+	int32 Num() const { return Count; }
+	bool IsValidIndex(int32 Index) const { return Index >= 0 && Index < Count; }
+
+	/** Read-only view of the elements. Valid until this handle is modified or destroyed. */
+	TArrayView<const int32> View() const { return TArrayView<const int32>(Storage.IsValid() ? Storage->GetData() + Offset : nullptr, Count); }
+
+	/** Returns a handle to Count elements starting at Start, sharing this handle's storage. The range is clamped to the array. */
+	FNumericArrayHandle Slice(int32 Start, int32 InCount) const;
+
+	/** Returns a copy of the elements. */
+	TArray<int32> ToArray() const { return TArray<int32>(View()); }
+
+	/** Returns a mutable view of the elements, first copying them into storage of their own if it is shared or larger than this slice. */
+	TArrayView<int32> Mutate();
+
+	/** Like Mutate, but for callers that overwrite every element: storage of its own is allocated without copying the old elements. */
+	TArrayView<int32> Overwrite();
+
+	/** Returns true if another handle refers to the same storage. */
+	bool IsShared() const { return Storage.IsValid() && !Storage.IsUnique(); }
+
+private:
+	TSharedPtr<TArray<int32>, ESPMode::ThreadSafe> Storage;
+	int32 Offset = 0;
+	int32 Count = 0;
+};
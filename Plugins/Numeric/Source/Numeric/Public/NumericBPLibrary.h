@@ -11,6 +11,11 @@
 #include "UObject/ScriptMacros.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "UObject/UnrealTypePrivate.h"
+#include "NumericArrayDiff.h"
+#include "NumericArrayHandle.h"
+#include "NumericMask.h"
+#include "NumericSlidingWindow.h"
+#include "NumericSortedIndex.h"
 #include "NumericBPLibrary.generated.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogArrayUtils, Log, All);
@@ -178,6 +183,7 @@ class UNumericBPLibrary : public UBlueprintFunctionLibrary
 
 	/**
 	* Returns the inner product of two arrays. Arrays must have the same length, otherwise 0 will be returned.
+	* The sum wraps around at 32 bits; InnerProduct64 cannot overflow and reports a length mismatch through its Success flag.
 	*
 	* @param A The first array.
 	* @param B The second array.
@@ -187,6 +193,19 @@ class UNumericBPLibrary : public UBlueprintFunctionLibrary
 	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "INNER PRODUCT",Category = "Array Utils", ToolTip = "Returns the inner product of two arrays. Arrays must have the same length, otherwise -1 will be returned."))
 	static int32 InnerProduct(const TArray<int32>& A, const TArray<int32>& B, int32 StartIndex = 0);
 
+	/**
+	 * Returns the inner product of two arrays, accumulating in int64 so the sum cannot overflow.
+	 *
+	 * @param A The first array.
+	 * @param B The second array.
+	 * @param StartIndex The initial value for the inner product calculation.
+	 * @param Success (Out) Whether the arrays have the same length. Empty arrays are valid and give StartIndex.
+	 * @return The inner product of the two arrays plus StartIndex, 0 on failure.
+	 * @note innerproduct64({1,2,3}, {4,5,6}) -> 32
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "INNER PRODUCT 64", Category = "Array Utils", ToolTip = "Returns the inner product of two arrays of the same length, accumulated in 64 bits. Example: innerproduct64({1,2,3}, {4,5,6}) -> 32"))
+	static int64 InnerProduct64(const TArray<int32>& A, const TArray<int32>& B, int64 StartIndex, bool& Success);
+
 	/**
 	 * Returns the number of elements in the array that are equal to the specified value. For example, {1, 1, 2, 3, 3, 3, 4} has 2 elements equal to 1.
 	 *
@@ -490,4 +509,745 @@ class UNumericBPLibrary : public UBlueprintFunctionLibrary
 	UFUNCTION(BlueprintCallable, Blueprintable, meta = (CompactNodeTitle = "TAKE", Category = "Array Utils", ToolTip = "Take N items from the beginning of the input array and copy them to a new array. If N is larger than size of the input array, all items from the input array are selected."))
 	static TArray<int32> ArrayTake(const TArray<int32>& A, int32 N);
 
+	/**
+	 * Returns the maximum value of an int32 binary file, streamed in chunks so the file may be larger than memory.
+	 *
+	 * @param Path Path of a raw file of int32 values.
+	 * @param Success (Out) Whether the file could be read.
+	 * @return The maximum value in the file, -1 if it is empty or unreadable.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "FILE MAX", Category = "Array Utils", ToolTip = "Returns the maximum value of a raw int32 file, streamed in chunks"))
+	static int32 FileArrayMax(const FString& Path, bool& Success);
+
+	/**
+	 * Returns the minimum value of an int32 binary file, streamed in chunks so the file may be larger than memory.
+	 *
+	 * @param Path Path of a raw file of int32 values.
+	 * @param Success (Out) Whether the file could be read.
+	 * @return The minimum value in the file, -1 if it is empty or unreadable.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "FILE MIN", Category = "Array Utils", ToolTip = "Returns the minimum value of a raw int32 file, streamed in chunks"))
+	static int32 FileArrayMin(const FString& Path, bool& Success);
+
+	/**
+	 * Returns the minimum and maximum value of an int32 binary file, streamed in chunks.
+	 *
+	 * @param Path Path of a raw file of int32 values.
+	 * @param Min (Out) The minimum value in the file.
+	 * @param Max (Out) The maximum value in the file.
+	 * @param Success (Out) Whether the file could be read and is not empty.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "FILE MIN MAX", Category = "Array Utils", ToolTip = "Returns the minimum and maximum value of a raw int32 file, streamed in chunks"))
+	static void FileArrayMinMax(const FString& Path, int32& Min, int32& Max, bool& Success);
+
+	/**
+	 * Returns the sum of all elements of an int32 binary file. The sum is 64-bit, as large files easily overflow int32.
+	 *
+	 * @param Path Path of a raw file of int32 values.
+	 * @param Success (Out) Whether the file could be read.
+	 * @return The sum of all elements in the file.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "FILE SUM", Category = "Array Utils", ToolTip = "Returns the 64-bit sum of all elements of a raw int32 file, streamed in chunks"))
+	static int64 FileAccumulate(const FString& Path, bool& Success);
+
+	/**
+	 * Returns the number of elements in an int32 binary file that are equal to the specified value.
+	 *
+	 * @param Path Path of a raw file of int32 values.
+	 * @param Value The value to count.
+	 * @param Success (Out) Whether the file could be read.
+	 * @return The count of elements equal to the value.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "FILE COUNT", Category = "Array Utils", ToolTip = "Returns the number of elements of a raw int32 file equal to the specified value"))
+	static int64 FileCount(const FString& Path, int32 Value, bool& Success);
+
+	/**
+	 * Searches an int32 binary file for the first occurrence of a sequence. Matches that straddle chunk boundaries are found.
+	 *
+	 * @param Path Path of a raw file of int32 values.
+	 * @param B Sub range to search for.
+	 * @param found (Out) Whether the sub range was found.
+	 * @param Success (Out) Whether the file could be read. A read error is not reported as "not found".
+	 * @return Index in which the sub range starts if found, -1 otherwise.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "FILE SEARCH RANGE", Category = "Array Utils", ToolTip = "Searches a raw int32 file for the first occurrence of the sequence, streamed in chunks"))
+	static int64 FileSearch(const FString& Path, const TArray<int32>& B, bool& found, bool& Success);
+
+	/**
+	 * Returns true if an int32 binary file is sorted in ascending order, comparing across chunk boundaries.
+	 *
+	 * @param Path Path of a raw file of int32 values.
+	 * @param Success (Out) Whether the file could be read.
+	 * @return true if the file could be read and is sorted, false otherwise.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "FILE IS SORTED?", Category = "Array Utils", ToolTip = "Returns true if a raw int32 file is sorted in ascending order"))
+	static bool FileIsSorted(const FString& Path, bool& Success);
+
+	/**
+	 * Writes the partial sums of an int32 binary file to another file, carrying the running sum across chunks.
+	 *
+	 * @param InPath Path of a raw file of int32 values.
+	 * @param OutPath Path of the file to write the partial sums to.
+	 * @return Whether both files could be read and written.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "FILE PARTIAL SUM", Category = "Array Utils", ToolTip = "Writes the partial sums of a raw int32 file to another file, streamed in chunks"))
+	static bool FilePartialSum(const FString& InPath, const FString& OutPath);
+
+	/**
+	 * Encodes the array in the plugin's compact binary format, choosing the cheapest encoding per block of elements.
+	 *
+	 * @param A The input array.
+	 * @return The encoded bytes.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "COMPACT ENCODE", Category = "Array Utils", ToolTip = "Encodes the array in a compact binary format. Sorted, repetitive or small-range arrays take far less than 4 bytes per element."))
+	static TArray<uint8> CompactEncode(const TArray<int32>& A);
+
+	/**
+	 * Decodes bytes produced by CompactEncode.
+	 *
+	 * @param Bytes The encoded bytes.
+	 * @param Success (Out) Whether the bytes could be decoded.
+	 * @return The decoded array, empty on failure.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "COMPACT DECODE", Category = "Array Utils", ToolTip = "Decodes bytes produced by Compact Encode back into an array"))
+	static TArray<int32> CompactDecode(const TArray<uint8>& Bytes, bool& Success);
+
+	/**
+	 * Returns the edits that turn A into B. Unlike Mismatch, every difference is reported, and inserted or removed elements are detected as such.
+	 *
+	 * @param A The source array.
+	 * @param B The target array.
+	 * @return The hunks to apply to A, sorted by index.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "DIFF", Category = "Array Utils", ToolTip = "Returns the replaced, inserted and removed ranges that turn A into B. Send these instead of the whole array and rebuild it with Apply Patch."))
+	static TArray<FNumericArrayHunk> DiffArrays(const TArray<int32>& A, const TArray<int32>& B);
+
+	/**
+	 * Applies hunks produced by DiffArrays to an array.
+	 *
+	 * @param A The source array.
+	 * @param Hunks The edits to apply.
+	 * @param Success (Out) Whether the hunks fit the array.
+	 * @return The patched array, empty on failure.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "APPLY PATCH", Category = "Array Utils", ToolTip = "Applies the hunks produced by Diff to the source array"))
+	static TArray<int32> ApplyPatch(const TArray<int32>& A, const TArray<FNumericArrayHunk>& Hunks, bool& Success);
+
+	/**
+	 * Returns the sum of each window of the array, in O(N) regardless of the window size.
+	 *
+	 * @param A The input array.
+	 * @param WindowSize Number of elements per window.
+	 * @param Stride Distance between the starts of consecutive windows.
+	 * @return One sum per window, empty if the window does not fit the array.
+	 * @note movingsum({1,2,3,4,5}, 3, 1) -> {6,9,12}
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "MOVING SUM", Category = "Array Utils", ToolTip = "Returns the sum of each window of the array. Example: movingsum({1,2,3,4,5}, 3, 1) -> {6,9,12}"))
+	static TArray<int32> MovingSum(const TArray<int32>& A, int32 WindowSize, int32 Stride = 1);
+
+	/**
+	 * Returns the mean of each window of the array, in O(N) regardless of the window size.
+	 *
+	 * @param A The input array.
+	 * @param WindowSize Number of elements per window.
+	 * @param Stride Distance between the starts of consecutive windows.
+	 * @return One mean per window, empty if the window does not fit the array.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "MOVING MEAN", Category = "Array Utils", ToolTip = "Returns the mean of each window of the array. Example: movingmean({1,2,3,4}, 2, 2) -> {1.5,3.5}"))
+	static TArray<double> MovingMean(const TArray<int32>& A, int32 WindowSize, int32 Stride = 1);
+
+	/**
+	 * Returns the minimum of each window of the array, in O(N) regardless of the window size.
+	 *
+	 * @param A The input array.
+	 * @param WindowSize Number of elements per window.
+	 * @param Stride Distance between the starts of consecutive windows.
+	 * @return One minimum per window, empty if the window does not fit the array.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "MOVING MIN", Category = "Array Utils", ToolTip = "Returns the minimum of each window of the array. Example: movingmin({4,2,3,1}, 2, 1) -> {2,2,1}"))
+	static TArray<int32> MovingMin(const TArray<int32>& A, int32 WindowSize, int32 Stride = 1);
+
+	/**
+	 * Returns the maximum of each window of the array, in O(N) regardless of the window size.
+	 *
+	 * @param A The input array.
+	 * @param WindowSize Number of elements per window.
+	 * @param Stride Distance between the starts of consecutive windows.
+	 * @return One maximum per window, empty if the window does not fit the array.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "MOVING MAX", Category = "Array Utils", ToolTip = "Returns the maximum of each window of the array. Example: movingmax({4,2,3,1}, 2, 1) -> {4,3,3}"))
+	static TArray<int32> MovingMax(const TArray<int32>& A, int32 WindowSize, int32 Stride = 1);
+
+	/**
+	 * Creates an empty sliding window over a stream of samples.
+	 *
+	 * @param WindowSize Number of most recent samples the window covers.
+	 * @return The sliding window.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "MAKE SLIDING WINDOW", Category = "Array Utils", ToolTip = "Creates an empty sliding window over the last WindowSize samples of a stream"))
+	static FNumericSlidingWindow MakeSlidingWindow(int32 WindowSize);
+
+	/**
+	 * Adds a sample to a sliding window, evicting the oldest one once it is full. Takes amortized O(1) time.
+	 *
+	 * @param Window The sliding window.
+	 * @param Sample The new sample.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "PUSH SAMPLE", Category = "Array Utils", ToolTip = "Adds a sample to the sliding window, evicting the oldest one once it is full"))
+	static void SlidingWindowPush(UPARAM(ref) FNumericSlidingWindow& Window, int32 Sample);
+
+	/**
+	 * Returns the aggregates of the samples currently in a sliding window. All values are 0 for an empty window.
+	 *
+	 * @param Window The sliding window.
+	 * @param Sum (Out) Sum of the samples.
+	 * @param Min (Out) Minimum sample.
+	 * @param Max (Out) Maximum sample.
+	 * @param Mean (Out) Mean of the samples.
+	 * @return Number of samples in the window.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "SLIDING WINDOW STATS", Category = "Array Utils", ToolTip = "Returns the sum, minimum, maximum and mean of the samples in the sliding window"))
+	static int32 SlidingWindowStats(const FNumericSlidingWindow& Window, int64& Sum, int32& Min, int32& Max, double& Mean);
+
+	/**
+	 * Returns the indices that would sort the array in ascending order. Equal elements keep their relative order.
+	 *
+	 * @param A The input array.
+	 * @return The sorting permutation: A[Result[0]] <= A[Result[1]] <= ...
+	 * @note argsort({30,10,20}) -> {1,2,0}
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "ARGSORT", Category = "Array Utils", ToolTip = "Returns the indices that would sort the array in ascending order. Example: argsort({30,10,20}) -> {1,2,0}"))
+	static TArray<int32> ArgSort(const TArray<int32>& A);
+
+	/**
+	 * Sorts the keys in ascending order and reorders the values the same way, keeping the relative order of equal keys.
+	 *
+	 * @param Keys The array to sort by.
+	 * @param Values The array reordered alongside the keys. Must have the same length as Keys.
+	 * @param SortedKeys (Out) The sorted keys.
+	 * @param SortedValues (Out) The values in key order.
+	 * @return Whether the arrays have the same length.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "SORT BY KEY", Category = "Array Utils", ToolTip = "Sorts the keys in ascending order and reorders the values the same way. Example: sortbykey({3,1,2}, {30,10,20}) -> {1,2,3}, {10,20,30}"))
+	static bool SortByKey(const TArray<int32>& Keys, const TArray<int32>& Values, TArray<int32>& SortedKeys, TArray<int32>& SortedValues);
+
+	/**
+	 * Reorders the array by a list of indices, such as one returned by ArgSort.
+	 *
+	 * @param A The input array.
+	 * @param Indices The indices to read, in output order.
+	 * @param Success (Out) Whether every index is within the array.
+	 * @return The array with Result[i] = A[Indices[i]], empty on failure.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "GATHER", Category = "Array Utils", ToolTip = "Returns the elements of the array at the given indices. Example: gather({10,20,30}, {2,0}) -> {30,10}"))
+	static TArray<int32> Gather(const TArray<int32>& A, const TArray<int32>& Indices, bool& Success);
+
+	/**
+	 * Writes each element of the array to the position given by a permutation, undoing a Gather with the same permutation.
+	 *
+	 * @param A The input array.
+	 * @param Permutation The destination of each element. Must hold each index of A exactly once.
+	 * @param Success (Out) Whether Permutation is a permutation of A's indices.
+	 * @return The array with Result[Permutation[i]] = A[i], empty on failure.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "SCATTER", Category = "Array Utils", ToolTip = "Moves each element to the index given by the permutation. Example: scatter({30,10,20}, {2,0,1}) -> {10,20,30}"))
+	static TArray<int32> Scatter(const TArray<int32>& A, const TArray<int32>& Permutation, bool& Success);
+
+	/**
+	 * Returns the index of the first element not less than the value in an array sorted in ascending order.
+	 *
+	 * @param A The input array, sorted in ascending order.
+	 * @param Value The value to search for.
+	 * @return The index of the first element >= Value, or A.Num() if there is none.
+	 * @note lowerbound({1,2,2,4}, 2) -> 1
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (CompactNodeTitle = "LOWER BOUND", Category = "Array Utils", ToolTip = "Returns the index of the first element not less than the value in a sorted array, or the array length if there is none. Example: lowerbound({1,2,2,4}, 2) -> 1"))
+	static int32 LowerBound(const TArray<int32>& A, int32 Value);
+
+	/**
+	 * Returns the index of the first element greater than the value in an array sorted in ascending order.
+	 *
+	 * @param A The input array, sorted in ascending order.
+	 * @param Value The value to search for.
+	 * @return The index of the first element > Value, or A.Num() if there is none.
+	 * @note upperbound({1,2,2,4}, 2) -> 3
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (CompactNodeTitle = "UPPER BOUND", Category = "Array Utils", ToolTip = "Returns the index of the first element greater than the value in a sorted array, or the array length if there is none. Example: upperbound({1,2,2,4}, 2) -> 3"))
+	static int32 UpperBound(const TArray<int32>& A, int32 Value);
+
+	/**
+	 * Returns the range of elements equal to the value in an array sorted in ascending order.
+	 *
+	 * @param A The input array, sorted in ascending order.
+	 * @param Value The value to search for.
+	 * @param First (Out) The index of the first element equal to Value.
+	 * @param Last (Out) The index after the last element equal to Value.
+	 * @return The number of elements equal to Value.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (CompactNodeTitle = "EQUAL RANGE", Category = "Array Utils", ToolTip = "Returns the range [First, Last) of elements equal to the value in a sorted array. Example: equalrange({1,2,2,4}, 2) -> [1,3)"))
+	static int32 EqualRange(const TArray<int32>& A, int32 Value, int32& First, int32& Last);
+
+	/**
+	 * Returns whether a value is in an array sorted in ascending order, in O(log N).
+	 *
+	 * @param A The input array, sorted in ascending order.
+	 * @param Value The value to search for.
+	 * @param found (Out) Whether the value was found.
+	 * @return The index of the first element equal to Value if found, -1 otherwise.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (CompactNodeTitle = "BINARY SEARCH", Category = "Array Utils", ToolTip = "Searches a sorted array for the value. Gives true and its first index if found, false and -1 otherwise."))
+	static int32 BinarySearch(const TArray<int32>& A, int32 Value, bool& found);
+
+	/**
+	 * Returns the lower bound of each value in an array sorted in ascending order. The searches run interleaved, so
+	 * their memory accesses overlap instead of waiting on each other.
+	 *
+	 * @param A The input array, sorted in ascending order.
+	 * @param Values The values to search for.
+	 * @return The lower bound of each value.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "BATCH LOWER BOUND", Category = "Array Utils", ToolTip = "Returns the lower bound of each value in a sorted array. Much faster than one Lower Bound per value for large batches."))
+	static TArray<int32> BatchLowerBound(const TArray<int32>& A, const TArray<int32>& Values);
+
+	/**
+	 * Builds a cache-friendly search index from an array sorted in ascending order, for repeated lookups into very large tables.
+	 *
+	 * @param A The input array, sorted in ascending order.
+	 * @param Success (Out) Whether the array is sorted.
+	 * @return The search index.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "MAKE SORTED INDEX", Category = "Array Utils", ToolTip = "Builds a cache-friendly search index from a sorted array, for repeated lookups into very large tables"))
+	static FNumericSortedIndex MakeSortedIndex(const TArray<int32>& A, bool& Success);
+
+	/**
+	 * Returns the lower bound of a value using a sorted index.
+	 *
+	 * @param Index The search index.
+	 * @param Value The value to search for.
+	 * @return The index in the original array of the first element >= Value, or its length if there is none.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (CompactNodeTitle = "INDEX LOWER BOUND", Category = "Array Utils", ToolTip = "Returns the lower bound of the value in the array the sorted index was built from"))
+	static int32 SortedIndexLowerBound(const FNumericSortedIndex& Index, int32 Value);
+
+	/**
+	 * Returns the lower bound of each value using a sorted index, with the searches interleaved.
+	 *
+	 * @param Index The search index.
+	 * @param Values The values to search for.
+	 * @return The lower bound of each value.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "INDEX BATCH LOWER BOUND", Category = "Array Utils", ToolTip = "Returns the lower bound of each value in the array the sorted index was built from"))
+	static TArray<int32> SortedIndexBatchLowerBound(const FNumericSortedIndex& Index, const TArray<int32>& Values);
+
+	/**
+	 * Wraps an array in a shared handle. Handles are passed between nodes without copying the elements.
+	 *
+	 * @param A The input array.
+	 * @return A handle owning a copy of the array.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "MAKE HANDLE", Category = "Array Utils", ToolTip = "Wraps the array in a shared handle that is passed between nodes without copying its elements"))
+	static FNumericArrayHandle MakeArrayHandle(const TArray<int32>& A);
+
+	/**
+	 * Copies the elements of a handle into a regular array.
+	 *
+	 * @param Handle The array handle.
+	 * @return The elements of the handle.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "TO ARRAY", Category = "Array Utils", ToolTip = "Copies the elements of the handle into a regular array"))
+	static TArray<int32> ArrayHandleToArray(const FNumericArrayHandle& Handle);
+
+	/**
+	 * Returns the number of elements of a handle.
+	 *
+	 * @param Handle The array handle.
+	 * @return The number of elements.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "HANDLE LENGTH", Category = "Array Utils", ToolTip = "Returns the number of elements of the handle"))
+	static int32 ArrayHandleNum(const FNumericArrayHandle& Handle);
+
+	/**
+	 * Returns the element of a handle at an index.
+	 *
+	 * @param Handle The array handle.
+	 * @param Index The index of the element.
+	 * @param IsValid (Out) Whether the index is within the handle.
+	 * @return The element, 0 if the index is invalid.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "HANDLE GET", Category = "Array Utils", ToolTip = "Returns the element of the handle at the index"))
+	static int32 ArrayHandleGet(const FNumericArrayHandle& Handle, int32 Index, bool& IsValid);
+
+	/**
+	 * Sets the element of a handle at an index. The elements are copied first only if their storage is shared with another handle.
+	 *
+	 * @param Handle The array handle.
+	 * @param Index The index of the element.
+	 * @param Value The new value.
+	 * @return Whether the index is within the handle.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "HANDLE SET", Category = "Array Utils", ToolTip = "Sets the element of the handle at the index, copying the elements first only if they are shared with another handle"))
+	static bool ArrayHandleSet(UPARAM(ref) FNumericArrayHandle& Handle, int32 Index, int32 Value);
+
+	/**
+	 * Returns a handle to the first N elements, sharing storage with the input. If N is larger than the handle, all elements are taken.
+	 *
+	 * @param Handle The array handle.
+	 * @param N Number of elements to take.
+	 * @return A handle to the first N elements.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "HANDLE TAKE", Category = "Array Utils", ToolTip = "Returns a handle to the first N elements without copying them"))
+	static FNumericArrayHandle ArrayHandleTake(const FNumericArrayHandle& Handle, int32 N);
+
+	/**
+	 * Returns a handle to a range of elements, sharing storage with the input. The range is clamped to the handle.
+	 *
+	 * @param Handle The array handle.
+	 * @param Start Index of the first element.
+	 * @param Count Number of elements.
+	 * @return A handle to the range.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "HANDLE SLICE", Category = "Array Utils", ToolTip = "Returns a handle to Count elements starting at Start without copying them"))
+	static FNumericArrayHandle ArrayHandleSlice(const FNumericArrayHandle& Handle, int32 Start, int32 Count);
+
+	/**
+	 * Returns the maximum value of a handle.
+	 *
+	 * @param Handle The array handle.
+	 * @return The maximum value, -1 if the handle is empty.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "HANDLE MAX", Category = "Array Utils", ToolTip = "Returns the maximum value of the handle"))
+	static int32 ArrayHandleMax(const FNumericArrayHandle& Handle);
+
+	/**
+	 * Returns the minimum value of a handle.
+	 *
+	 * @param Handle The array handle.
+	 * @return The minimum value, -1 if the handle is empty.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "HANDLE MIN", Category = "Array Utils", ToolTip = "Returns the minimum value of the handle"))
+	static int32 ArrayHandleMin(const FNumericArrayHandle& Handle);
+
+	/**
+	 * Returns the sum of all elements of a handle.
+	 *
+	 * @param Handle The array handle.
+	 * @return The sum of all elements, -1 if the handle is empty.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "HANDLE SUM", Category = "Array Utils", ToolTip = "Returns the sum of all elements of the handle"))
+	static int32 ArrayHandleAccumulate(const FNumericArrayHandle& Handle);
+
+	/**
+	 * Returns the number of elements of a handle equal to a value.
+	 *
+	 * @param Handle The array handle.
+	 * @param Value The value to count.
+	 * @return The count of elements equal to the value, -1 if the handle is empty.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "HANDLE COUNT", Category = "Array Utils", ToolTip = "Returns the number of elements of the handle equal to the value"))
+	static int32 ArrayHandleCount(const FNumericArrayHandle& Handle, int32 Value);
+
+	/**
+	 * Returns the handle whose elements sum to more, without copying either.
+	 *
+	 * @param A The first handle.
+	 * @param B The second handle.
+	 * @return The greater handle.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "BIGGEST HANDLE", Category = "Array Utils", ToolTip = "Returns the handle whose elements sum to more, without copying either"))
+	static FNumericArrayHandle BiggestArrayHandle(const FNumericArrayHandle& A, const FNumericArrayHandle& B);
+
+	/**
+	 * Returns the handle whose elements sum to less, without copying either.
+	 *
+	 * @param A The first handle.
+	 * @param B The second handle.
+	 * @return The smaller handle.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "SMALLEST HANDLE", Category = "Array Utils", ToolTip = "Returns the handle whose elements sum to less, without copying either"))
+	static FNumericArrayHandle SmallestArrayHandle(const FNumericArrayHandle& A, const FNumericArrayHandle& B);
+
+	/**
+	 * Returns the minimum and maximum values of a handle in a single call.
+	 *
+	 * @param Handle The array handle.
+	 * @param Min (Out) The minimum value, 0 if the handle is empty.
+	 * @param Max (Out) The maximum value, 0 if the handle is empty.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "HANDLE MIN MAX", Category = "Array Utils", ToolTip = "Returns the minimum and maximum values of the handle"))
+	static void ArrayHandleMinMax(const FNumericArrayHandle& Handle, int32& Min, int32& Max);
+
+	/**
+	 * Returns true if the elements of a handle are sorted in ascending order.
+	 *
+	 * @param Handle The array handle.
+	 * @return true if the elements are sorted, false otherwise.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "HANDLE IS SORTED?", Category = "Array Utils", ToolTip = "Returns true if the elements of the handle are sorted in ascending order"))
+	static bool ArrayHandleIsSorted(const FNumericArrayHandle& Handle);
+
+	/**
+	 * Returns true if two handles hold the same elements. Handles to the same range of the same storage compare equal without reading it.
+	 *
+	 * @param A The first handle.
+	 * @param B The second handle.
+	 * @return true if the handles are equal, false otherwise.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "HANDLE ==", Category = "Array Utils", ToolTip = "Returns true if the two handles hold the same elements"))
+	static bool ArrayHandleIsEqual(const FNumericArrayHandle& A, const FNumericArrayHandle& B);
+
+	/**
+	 * Returns the inner product of two handles of equal length, accumulated in int64.
+	 *
+	 * @param A The first handle.
+	 * @param B The second handle.
+	 * @param Success (Out) Whether the handles have the same length.
+	 * @return The inner product, 0 if the lengths differ.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "HANDLE INNER PRODUCT", Category = "Array Utils", ToolTip = "Returns the inner product of two handles of equal length, accumulated in int64"))
+	static int64 ArrayHandleInnerProduct(const FNumericArrayHandle& A, const FNumericArrayHandle& B, bool& Success);
+
+	/**
+	 * Returns the index of the first element not less than a value, in a handle sorted in ascending order.
+	 *
+	 * @param Handle The array handle, sorted in ascending order.
+	 * @param Value The value to search for.
+	 * @return The index of the first element >= Value, or the handle's length if there is none.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "HANDLE LOWER BOUND", Category = "Array Utils", ToolTip = "Returns the index of the first element of the sorted handle that is not less than the value"))
+	static int32 ArrayHandleLowerBound(const FNumericArrayHandle& Handle, int32 Value);
+
+	/**
+	 * Returns whether a value is in a handle sorted in ascending order, in O(log N).
+	 *
+	 * @param Handle The array handle, sorted in ascending order.
+	 * @param Value The value to search for.
+	 * @param found (Out) Whether the value was found.
+	 * @return The index of the first element equal to Value if found, -1 otherwise.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "HANDLE BINARY SEARCH", Category = "Array Utils", ToolTip = "Searches the sorted handle for the value. Gives true and its first index if found, false and -1 otherwise."))
+	static int32 ArrayHandleBinarySearch(const FNumericArrayHandle& Handle, int32 Value, bool& found);
+
+	/**
+	 * Sorts the elements of a handle in place. They are copied first only if their storage is shared with another handle.
+	 *
+	 * @param Handle The array handle.
+	 * @param bDescending Whether to sort in descending order.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "HANDLE SORT", Category = "Array Utils", ToolTip = "Sorts the elements of the handle in place, copying them first only if they are shared with another handle"))
+	static void ArrayHandleSort(UPARAM(ref) FNumericArrayHandle& Handle, bool bDescending = false);
+
+	/**
+	 * Sets every element of a handle to a value. Shared elements are not copied, since all of them are overwritten.
+	 *
+	 * @param Handle The array handle.
+	 * @param Value The value to fill the handle with.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "HANDLE FILL", Category = "Array Utils", ToolTip = "Sets every element of the handle to the value"))
+	static void ArrayHandleFill(UPARAM(ref) FNumericArrayHandle& Handle, int32 Value);
+
+	/**
+	 * Replaces every occurrence of a value in a handle. The elements are copied first only if one of them changes and their storage is shared.
+	 *
+	 * @param Handle The array handle.
+	 * @param OldValue The value to replace.
+	 * @param NewValue The value to replace it with.
+	 * @return The number of elements replaced.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "HANDLE REPLACE", Category = "Array Utils", ToolTip = "Replaces every occurrence of OldValue in the handle with NewValue"))
+	static int32 ArrayHandleReplace(UPARAM(ref) FNumericArrayHandle& Handle, int32 OldValue, int32 NewValue);
+
+	/**
+	 * Clamps every element of a handle between two values. The elements are copied first only if their storage is shared with another handle.
+	 *
+	 * @param Handle The array handle.
+	 * @param Min The minimum value.
+	 * @param Max The maximum value.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "HANDLE CLAMP", Category = "Array Utils", ToolTip = "Clamps every element of the handle between Min and Max"))
+	static void ArrayHandleClamp(UPARAM(ref) FNumericArrayHandle& Handle, int32 Min, int32 Max);
+
+	/**
+	 * Rotates the elements of a handle left by Amount positions, or right if Amount is negative. The elements are copied first only if their storage is shared with another handle.
+	 *
+	 * @param Handle The array handle.
+	 * @param Amount The number of positions to rotate by.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "HANDLE ROTATE", Category = "Array Utils", ToolTip = "Rotates the elements of the handle left by Amount positions, or right if Amount is negative"))
+	static void ArrayHandleRotate(UPARAM(ref) FNumericArrayHandle& Handle, int32 Amount);
+
+	/**
+	 * Removes consecutive duplicate elements. On a sorted array this leaves each distinct value once.
+	 *
+	 * @param A The input array.
+	 * @return The array without consecutive duplicates.
+	 * @note unique({1,1,2,2,2,3,1}) -> {1,2,3,1}
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "UNIQUE", Category = "Array Utils", ToolTip = "Removes consecutive duplicate elements. On a sorted array this leaves each distinct value once. Example: unique({1,1,2,2,2,3,1}) -> {1,2,3,1}"))
+	static TArray<int32> Unique(const TArray<int32>& A);
+
+	/**
+	 * Splits the array into runs of equal consecutive elements.
+	 *
+	 * @param A The input array.
+	 * @param Values (Out) The value of each run.
+	 * @param Counts (Out) The length of each run.
+	 * @note runlengthencode({5,5,5,2,5}) -> {5,2,5}, {3,1,1}
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "RUN LENGTH ENCODE", Category = "Array Utils", ToolTip = "Splits the array into runs of equal consecutive elements. Example: runlengthencode({5,5,5,2,5}) -> {5,2,5}, {3,1,1}"))
+	static void RunLengthEncode(const TArray<int32>& A, TArray<int32>& Values, TArray<int32>& Counts);
+
+	/**
+	 * Counts how many times each distinct value occurs, in a single pass. Replaces calling Count once per value.
+	 *
+	 * @param A The input array.
+	 * @param Values (Out) The distinct values, in ascending order.
+	 * @param Counts (Out) The number of occurrences of each value.
+	 * @note countbyvalue({3,1,3,3}) -> {1,3}, {1,3}
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "COUNT BY VALUE", Category = "Array Utils", ToolTip = "Counts how many times each distinct value occurs, in a single pass. Example: countbyvalue({3,1,3,3}) -> {1,3}, {1,3}"))
+	static void CountByValue(const TArray<int32>& A, TArray<int32>& Values, TArray<int32>& Counts);
+
+	/**
+	 * Compares every element against a value, packing the results into a mask with one bit per element.
+	 *
+	 * @param A The input array.
+	 * @param Value The value to compare against.
+	 * @return A mask with bit i set if A[i] == Value.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "MASK ==", Category = "Array Utils", ToolTip = "Returns a mask with one bit per element, set where the element equals the value"))
+	static FNumericMask MaskEqual(const TArray<int32>& A, int32 Value);
+
+	/**
+	 * Compares every element against a value, packing the results into a mask with one bit per element.
+	 *
+	 * @param A The input array.
+	 * @param Value The value to compare against.
+	 * @return A mask with bit i set if A[i] > Value.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "MASK >", Category = "Array Utils", ToolTip = "Returns a mask with one bit per element, set where the element is greater than the value"))
+	static FNumericMask MaskGreater(const TArray<int32>& A, int32 Value);
+
+	/**
+	 * Compares every element against a value, packing the results into a mask with one bit per element.
+	 *
+	 * @param A The input array.
+	 * @param Value The value to compare against.
+	 * @return A mask with bit i set if A[i] < Value.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "MASK <", Category = "Array Utils", ToolTip = "Returns a mask with one bit per element, set where the element is less than the value"))
+	static FNumericMask MaskLess(const TArray<int32>& A, int32 Value);
+
+	/**
+	 * Tests every element against an inclusive range, packing the results into a mask with one bit per element.
+	 *
+	 * @param A The input array.
+	 * @param Min The lower bound, inclusive.
+	 * @param Max The upper bound, inclusive.
+	 * @return A mask with bit i set if Min <= A[i] <= Max.
+	 * @note maskinrange({5,20,60}, 10, 50) sets only bit 1.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "MASK IN RANGE", Category = "Array Utils", ToolTip = "Returns a mask with one bit per element, set where the element is within [Min, Max]"))
+	static FNumericMask MaskInRange(const TArray<int32>& A, int32 Min, int32 Max);
+
+	/**
+	 * Combines two masks of the same length, keeping the bits set in both.
+	 *
+	 * @param A The first mask.
+	 * @param B The second mask.
+	 * @param Success (Out) Whether the masks have the same length.
+	 * @return The combined mask, empty on failure.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "MASK AND", Category = "Array Utils", ToolTip = "Returns the mask of bits set in both masks"))
+	static FNumericMask MaskAnd(const FNumericMask& A, const FNumericMask& B, bool& Success);
+
+	/**
+	 * Combines two masks of the same length, keeping the bits set in either.
+	 *
+	 * @param A The first mask.
+	 * @param B The second mask.
+	 * @param Success (Out) Whether the masks have the same length.
+	 * @return The combined mask, empty on failure.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "MASK OR", Category = "Array Utils", ToolTip = "Returns the mask of bits set in either mask"))
+	static FNumericMask MaskOr(const FNumericMask& A, const FNumericMask& B, bool& Success);
+
+	/**
+	 * Flips every bit of a mask.
+	 *
+	 * @param A The input mask.
+	 * @return The inverted mask.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "MASK NOT", Category = "Array Utils", ToolTip = "Returns the mask with every bit flipped"))
+	static FNumericMask MaskNot(const FNumericMask& A);
+
+	/**
+	 * Counts the set bits of a mask, 32 elements at a time.
+	 *
+	 * @param A The input mask.
+	 * @return The number of elements that passed the predicate.
+	 */
+	UFUNCTION(BlueprintPure, meta = (CompactNodeTitle = "MASK COUNT", Category = "Array Utils", ToolTip = "Returns the number of set bits of the mask"))
+	static int32 MaskCount(const FNumericMask& A);
+
+	/**
+	 * Returns the elements of the array whose bit is set in the mask, in order.
+	 *
+	 * @param A The input array.
+	 * @param Mask A mask with one bit per element of the array.
+	 * @param Success (Out) Whether the mask has as many bits as the array has elements.
+	 * @return The selected elements, empty on failure.
+	 * @note maskselect({5,20,60}, maskinrange({5,20,60}, 10, 50)) -> {20}
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "MASK SELECT", Category = "Array Utils", ToolTip = "Returns the elements of the array whose bit is set in the mask. Example: maskselect({5,20,60}, maskinrange({5,20,60}, 10, 50)) -> {20}"))
+	static TArray<int32> MaskSelect(const TArray<int32>& A, const FNumericMask& Mask, bool& Success);
+
+	/**
+	 * Returns the indices of the set bits of a mask, in ascending order.
+	 *
+	 * @param A The input mask.
+	 * @return The indices of the elements that passed the predicate.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "MASK INDICES", Category = "Array Utils", ToolTip = "Returns the indices of the set bits of the mask"))
+	static TArray<int32> MaskIndices(const FNumericMask& A);
+
+	/**
+	 * Computes the inner product of a query vector with every row of a row-major matrix, in one pass and accumulating in int64.
+	 *
+	 * @param Query The query vector.
+	 * @param Matrix The candidate vectors, stored one after another. Its length must be a multiple of the query's.
+	 * @param Success (Out) Whether the query is non-empty and the matrix holds a whole number of rows.
+	 * @return The inner product of the query with each row, empty on failure.
+	 * @note innerproductbatch({1,2}, {1,0, 0,1, 2,2}) -> {1,2,6}
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "INNER PRODUCT BATCH", Category = "Array Utils", ToolTip = "Returns the inner product of the query with each row of the matrix. Example: innerproductbatch({1,2}, {1,0, 0,1, 2,2}) -> {1,2,6}"))
+	static TArray<int64> InnerProductBatch(const TArray<int32>& Query, const TArray<int32>& Matrix, bool& Success);
+
+	/**
+	 * Multiplies a row-major matrix by a vector, accumulating in int64.
+	 *
+	 * @param Matrix The matrix, NumRows x Vector.Num(), row-major.
+	 * @param NumRows The number of rows of the matrix.
+	 * @param Vector The vector.
+	 * @param Success (Out) Whether the matrix has NumRows * Vector.Num() elements.
+	 * @return The NumRows elements of the product, empty on failure.
+	 * @note matrixvectormultiply({1,2, 3,4}, 2, {1,1}) -> {3,7}
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "MATRIX * VECTOR", Category = "Array Utils", ToolTip = "Multiplies a row-major matrix by a vector. Example: matrixvectormultiply({1,2, 3,4}, 2, {1,1}) -> {3,7}"))
+	static TArray<int64> MatrixVectorMultiply(const TArray<int32>& Matrix, int32 NumRows, const TArray<int32>& Vector, bool& Success);
+
+	/**
+	 * Multiplies two row-major matrices, accumulating in int64.
+	 *
+	 * @param A The left matrix, M x K, row-major.
+	 * @param B The right matrix, K x N, row-major.
+	 * @param M The number of rows of A.
+	 * @param K The number of columns of A and rows of B.
+	 * @param N The number of columns of B.
+	 * @param Success (Out) Whether the dimensions are positive and match the lengths of the matrices.
+	 * @return The M x N product, row-major, empty on failure.
+	 * @note matrixmultiply({1,2, 3,4}, {5,6, 7,8}, 2, 2, 2) -> {19,22, 43,50}
+	 */
+	UFUNCTION(BlueprintCallable, meta = (CompactNodeTitle = "MATRIX * MATRIX", Category = "Array Utils", ToolTip = "Multiplies two row-major matrices. Example: matrixmultiply({1,2, 3,4}, {5,6, 7,8}, 2, 2, 2) -> {19,22, 43,50}"))
+	static TArray<int64> MatrixMultiply(const TArray<int32>& A, const TArray<int32>& B, int32 M, int32 K, int32 N, bool& Success);
+
 };
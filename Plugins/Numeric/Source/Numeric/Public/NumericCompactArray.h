@@ -0,0 +1,49 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Compact, versioned binary format for int32 arrays.
+ *
+ * The array is split into blocks of BlockNum elements and each block is stored with whichever encoding is smallest:
+ * raw, zigzag varint, zigzag varint of deltas (sorted or smooth data), run-length, or bit-packed offsets from the block minimum.
+ * Full bit-packed blocks interleave four lanes of 32-bit words, so on x86 they are packed and unpacked four values per
+ * SSE2 instruction; the varint-based encodings are byte-serial and run at scalar speed.
+ * Encoded data starts with a format version byte, so data written by older plugin versions keeps decoding. Multi-byte
+ * values are little-endian, so encoded data also moves between platforms of either byte order.
+ */
+struct NUMERIC_API FNumericCompactArray
+{
+	/** Current format version, written at the start of every encoded buffer. */
+	static constexpr uint8 Version = 2;
+
+	/** Number of elements per block. */
+	static constexpr int32 BlockNum = 128;
+
+	/** Per-block encodings. Values are part of the format and must never change. */
+	enum class EEncoding : uint8
+	{
+		Raw = 0,
+		Varint = 1,
+		Delta = 2,
+		RunLength = 3,
+		BitPacked = 4,
+		/** BitPacked for full blocks, with element i in lane i % 4 and each lane packed into every fourth word. Since version 2. */
+		BitPackedLanes = 5,
+	};
+
+	/** Encodes A into Out, replacing its contents. */
+	static void Encode(const TArray<int32>& A, TArray<uint8>& Out);
+
+	/**
+	 * Decodes a buffer produced by Encode into Out.
+	 *
+	 * @return false if the buffer is truncated, corrupt or written by a newer format version.
+	 */
+	static bool Decode(TArrayView<const uint8> Data, TArray<int32>& Out);
+
+	/** Serializes A in the compact format. Sets an error on the archive if loading fails. */
+	static void Serialize(FArchive& Ar, TArray<int32>& A);
+};
@@ -0,0 +1,111 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+
+/** Input sizes at which the library switches to a faster algorithm. */
+enum class ENumericThreshold : uint8
+{
+	/** ArgSort and SortByKey use the radix sort from this many elements. */
+	RadixSort,
+	/** Radix passes, gathers and scatters run on worker threads from this many elements. */
+	ParallelSort,
+	/** Fill, Iota, Clamp and the other elementwise functions run on worker threads from this many elements. */
+	ParallelTransform,
+	/** Elementwise functions write with non-temporal stores from this many elements. */
+	StreamingStore,
+	/** Dot product batches and matrix products run on worker threads from this many multiply-adds. */
+	ParallelMatrix,
+	/** SortAscending, SortDescending and the stable sorts use the radix sort from this many elements. */
+	RadixSortValues,
+
+	Count
+};
+
+/**
+ * Table of the size thresholds the library dispatches on.
+ *
+ * The best crossovers depend on the host CPU and core count, so the defaults can be replaced by a quick calibration at
+ * startup, cached per host in the saved engine config. Enable it with
+ *
+ *	[Numeric.Dispatch]
+ *	bCalibrateOnStartup=True
+ *	CalibrationBudgetMs=250
+ *
+ * If the worker threads are not running yet when the module starts, calibration waits until the engine has initialized.
+ * Only measured thresholds are cached, so a profile missing some is completed by the next calibration.
+ *
+ * Console commands: Numeric.Dispatch (print), Numeric.Dispatch.Set <Name> <Value>, Numeric.Dispatch.Calibrate [BudgetMs], Numeric.Dispatch.Reset.
+ */
+struct NUMERIC_API FNumericDispatch
+{
+	/** Returns the current value of a threshold. Safe to call from any thread. */
+	static int32 Get(ENumericThreshold Threshold);
+
+	/** Overrides a threshold. */
+	static void Set(ENumericThreshold Threshold, int32 Value);
+
+	/** Restores every threshold to its built-in default and forgets the measured ones, so SaveProfile no longer caches them. Call from the game thread. */
+	static void ResetToDefaults();
+
+	/** Returns the name used for a threshold in the config and console, or nullptr for an invalid value. */
+	static const TCHAR* GetName(ENumericThreshold Threshold);
+
+	/**
+	 * Measures the crossovers on this host and updates the table, stopping once BudgetSeconds have elapsed. Each path
+	 * is timed directly and only the results are published, so the library can keep running on other threads.
+	 * Thresholds that could not be measured in time, or need the worker threads while they are not running, keep
+	 * their current value. Call from the game thread.
+	 * @param bMissingOnly Skip the thresholds already measured or loaded from the profile.
+	 */
+	static void Calibrate(double BudgetSeconds, bool bMissingOnly = false);
+
+	/** Loads the thresholds cached for this host. Returns false unless the profile has every measurable threshold. */
+	static bool LoadProfile();
+
+	/** Caches the thresholds measured or loaded for this host, leaving out any that never were. */
+	static void SaveProfile();
+
+	/** Loads the cached profile, or calibrates if enabled in the config. Called by the module on startup. */
+	static void Startup();
+
+	/**
+	 * Returns how many parts to split Work units of work into: 1 below Threshold or while the worker threads are not
+	 * running, otherwise one per MinChunkWork units, at most one per worker thread plus the calling thread.
+	 */
+	static int32 NumParallelChunks(ENumericThreshold Threshold, int64 Work, int64 MinChunkWork);
+
+	/** Like NumParallelChunks for work at or above the threshold, whatever its value. */
+	static int32 MaxParallelChunks(int64 Work, int64 MinChunkWork);
+
+	/**
+	 * Runs Body(Begin, End) over [0, Num) in NumChunks contiguous ranges of near-equal size, on worker threads when
+	 * NumChunks > 1. If Data is given, it is the array the ranges write to, with ElementSize bytes per element, and the
+	 * boundaries are rounded to its cache lines so no two ranges write to the same line. Ranges may be empty.
+	 */
+	template <typename BodyType>
+	static void ParallelRanges(int32 Num, int32 NumChunks, BodyType&& Body, const void* Data = nullptr, int32 ElementSize = 1)
+	{
+		if (NumChunks <= 1)
+		{
+			Body(0, Num);
+			return;
+		}
+
+		// TArray only guarantees 16-byte alignment, so lines are counted from the first one that starts inside Data.
+		const int32 LineNum = Data ? FMath::Max(PLATFORM_CACHE_LINE_SIZE / ElementSize, 1) : 1;
+		const int32 Lead = Data ? (int32)((Align((UPTRINT)Data, PLATFORM_CACHE_LINE_SIZE) - (UPTRINT)Data) / ElementSize) : 0;
+		auto RangeBegin = [Num, NumChunks, LineNum, Lead](int32 Chunk)
+		{
+			const int64 Begin = (int64)Num * Chunk / NumChunks;
+			return Chunk == 0 || Chunk == NumChunks ? (int32)Begin : (int32)FMath::Min<int64>(Num, Lead + Align(FMath::Max<int64>(Begin - Lead, 0), LineNum));
+		};
+
+		ParallelFor(NumChunks, [&Body, &RangeBegin](int32 Chunk)
+		{
+			Body(RangeBegin(Chunk), RangeBegin(Chunk + 1));
+		});
+	}
+};
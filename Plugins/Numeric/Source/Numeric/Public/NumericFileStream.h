@@ -0,0 +1,43 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Streams a raw binary file of native-endian int32 values in fixed-size chunks, so the library's kernels can run over
+ * arrays larger than memory. Only two chunk buffers are ever resident: the next chunk is read on a worker thread while
+ * the current one is being processed.
+ */
+class NUMERIC_API FNumericFileStream
+{
+public:
+	/** Default number of elements per chunk (16 MB of int32). */
+	static constexpr int32 DefaultChunkNum = 4 * 1024 * 1024;
+
+	/**
+	 * @param InPath Path of the file to stream.
+	 * @param InChunkNum Number of elements read per chunk.
+	 */
+	explicit FNumericFileStream(const FString& InPath, int32 InChunkNum = DefaultChunkNum);
+
+	/** Returns true if the file exists and its size is a whole number of int32 elements. */
+	bool IsValid() const { return NumElements >= 0; }
+
+	/** Returns the number of int32 elements in the file, or -1 if the file is not valid. */
+	int64 Num() const { return NumElements; }
+
+	/**
+	 * Visits the file chunk by chunk, in order.
+	 *
+	 * @param Visitor Called as Visitor(Data, Num, FirstIndex), where FirstIndex is the file index of Data[0]. Return false to stop early.
+	 * @param Overlap Number of trailing elements of the previous chunk repeated in front of each chunk, for kernels whose state straddles chunk boundaries.
+	 * @return false if the file could not be opened or read.
+	 */
+	bool ForEachChunk(TFunctionRef<bool(const int32* Data, int32 Num, int64 FirstIndex)> Visitor, int32 Overlap = 0) const;
+
+private:
+	FString Path;
+	int32 ChunkNum;
+	int64 NumElements;
+};
@@ -0,0 +1,93 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NumericDispatch.h"
+#include "NumericMask.generated.h"
+
+/**
+ * Packed bitset with one bit per array element, produced by comparing an array against a predicate.
+ *
+ * Masks are combined a word (32 elements) at a time, counted with popcount and used to select elements, so a compound
+ * filter costs one pass per predicate over a buffer 1/32 the size of a bool array. Bits past Num are always zero.
+ */
+USTRUCT(BlueprintType)
+struct NUMERIC_API FNumericMask
+{
+	GENERATED_BODY()
+
+	static constexpr int32 BitsPerWord = 32;
+
+	/** Masks are built in chunks of at least this many elements per worker thread. */
+	static constexpr int32 MinChunkNum = 64 * 1024;
+
+	FNumericMask() = default;
+	explicit FNumericMask(int32 InNum, bool bValue = false);
+
+	/** Returns a mask with bit i set if Predicate(A[i]) is true. Predicate must be safe to call from several threads. */
+	template <typename PredicateType>
+	static FNumericMask FromPredicate(TArrayView<const int32> A, PredicateType Predicate)
+	{
+		FNumericMask Mask;
+		Mask.Count = A.Num();
+		Mask.Words.SetNumUninitialized(FMath::DivideAndRoundUp(A.Num(), BitsPerWord));
+
+		const int32* Data = A.GetData();
+		const int32 Num = A.Num();
+		uint32* Out = Mask.Words.GetData();
+		const int32 NumChunks = FNumericDispatch::NumParallelChunks(ENumericThreshold::ParallelTransform, Num, MinChunkNum);
+		FNumericDispatch::ParallelRanges(Mask.Words.Num(), NumChunks, [Data, Num, Out, &Predicate](int32 BeginWord, int32 EndWord)
+		{
+			for (int32 WordIndex = BeginWord; WordIndex < EndWord; ++WordIndex)
+			{
+				const int32 Base = WordIndex * BitsPerWord;
+				const int32 NumBits = FMath::Min(BitsPerWord, Num - Base);
+
+				// Build the word with shifts and ors only, so the loop has no data-dependent branch and vectorizes.
+				uint32 Word = 0;
+				for (int32 Bit = 0; Bit < NumBits; ++Bit)
+				{
+					Word |= (uint32)(bool)Predicate(Data[Base + Bit]) << Bit;
+				}
+				Out[WordIndex] = Word;
+			}
+		}, Out, sizeof(uint32));
+		return Mask;
+	}
+
+	int32 Num() const { return Count; }
+	bool Get(int32 Index) const { return (Words[Index / BitsPerWord] >> (Index % BitsPerWord)) & 1u; }
+	TArrayView<const uint32> GetWords() const { return Words; }
+
+	/** Number of set bits. */
+	int32 CountSetBits() const;
+
+	/** Elementwise operators. Both masks must have the same Num. */
+	FNumericMask operator&(const FNumericMask& Other) const;
+	FNumericMask operator|(const FNumericMask& Other) const;
+	FNumericMask operator~() const;
+
+	/** Returns the elements of A whose bit is set, in order. A must have Num elements. */
+	TArray<int32> Select(TArrayView<const int32> A) const;
+
+	/** Returns the indices of the set bits, in ascending order. */
+	TArray<int32> Indices() const;
+
+private:
+	/** Calls Visitor(Index) for every set bit, in ascending order. */
+	template <typename VisitorType>
+	void ForEachSetBit(VisitorType Visitor) const
+	{
+		for (int32 WordIndex = 0; WordIndex < Words.Num(); ++WordIndex)
+		{
+			for (uint32 Word = Words[WordIndex]; Word != 0; Word &= Word - 1)
+			{
+				Visitor(WordIndex * BitsPerWord + (int32)FMath::CountTrailingZeros(Word));
+			}
+		}
+	}
+
+	TArray<uint32> Words;
+	int32 Count = 0;
+};
@@ -0,0 +1,27 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Dot products and small matrix kernels over row-major int32 matrices, accumulating in int64 so no intermediate sum
+ * overflows. Rows are split across worker threads once the number of multiply-adds reaches ENumericThreshold::ParallelMatrix.
+ */
+struct NUMERIC_API FNumericMatrix
+{
+	/** Multiply-adds per worker thread below which the rows are not split further, tens of microseconds of work. */
+	static constexpr int64 MinChunkWork = 64 * 1024;
+
+	/** Returns the sum of A[i] * B[i] over [0, Num). */
+	static int64 Dot(const int32* A, const int32* B, int32 Num);
+
+	/** Sets Out[r] = Dot(row r of Matrix, Vector) for a NumRows x Vector.Num() Matrix. Out must have NumRows elements. */
+	static void MatrixVector(TArrayView<const int32> Matrix, int32 NumRows, TArrayView<const int32> Vector, int64* Out);
+
+	/** Sets Out = A * B for an M x K matrix A and a K x N matrix B. Out must have M * N elements. */
+	static void MatrixMultiply(TArrayView<const int32> A, TArrayView<const int32> B, int32 M, int32 K, int32 N, int64* Out);
+
+	/** MatrixMultiply with the rows split into NumChunks ranges regardless of the dispatch table. Used to time the paths against each other. */
+	static void MatrixMultiply(TArrayView<const int32> A, TArrayView<const int32> B, int32 M, int32 K, int32 N, int64* Out, int32 NumChunks);
+};
@@ -0,0 +1,65 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NumericSlidingWindow.generated.h"
+
+/**
+ * Sum, minimum, maximum and mean of the last WindowSize samples of a stream, updated in amortized O(1) per sample.
+ * Minimum and maximum are kept in monotonic queues, so no rescan of the window is ever needed.
+ */
+USTRUCT(BlueprintType)
+struct NUMERIC_API FNumericSlidingWindow
+{
+	GENERATED_BODY()
+
+	FNumericSlidingWindow() = default;
+	explicit FNumericSlidingWindow(int32 InWindowSize);
+
+	/** Adds a sample, evicting the oldest one once the window is full. */
+	void Push(int32 Sample);
+
+	/** Clears all samples, keeping the window size. */
+	void Reset();
+
+	/** Number of samples currently in the window, at most WindowSize. */
+	int32 Num() const { return Count; }
+	int32 GetWindowSize() const { return WindowSize; }
+
+	int64 Sum() const { return RunningSum; }
+	int32 Min() const { return Count > 0 ? MinQueue.Front() : 0; }
+	int32 Max() const { return Count > 0 ? MaxQueue.Front() : 0; }
+	double Mean() const { return Count > 0 ? (double)RunningSum / Count : 0.0; }
+
+private:
+	/** Ring buffer of (sample index, value) pairs with values kept monotonic from front to back. */
+	struct FMonotonicQueue
+	{
+		TArray<TPair<int64, int32>> Items;
+		int32 Head = 0;
+		int32 Num = 0;
+
+		void Init(int32 Capacity);
+		int32 Front() const { return Items[Head].Value; }
+
+		/** Drops entries that fall out of the window ending at Index, then pushes Value, dropping every entry that Value dominates. */
+		template <typename DominatesType>
+		void Push(int64 Index, int32 Value, int32 WindowSize, DominatesType Dominates);
+	};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Array Utils", meta = (AllowPrivateAccess = "true"))
+	int32 WindowSize = 0;
+
+	TArray<int32> Samples;
+	int32 Count = 0;
+
+	/** Slot of Samples the next sample goes to, wrapping at WindowSize. */
+	int32 NextSlot = 0;
+
+	/** Index of the next sample in the stream, which orders the queue entries and never wraps. */
+	int64 NextIndex = 0;
+	int64 RunningSum = 0;
+	FMonotonicQueue MinQueue;
+	FMonotonicQueue MaxQueue;
+};
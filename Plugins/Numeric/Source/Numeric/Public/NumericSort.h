@@ -0,0 +1,96 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NumericDispatch.h"
+
+/**
+ * Index-based sorting for structure-of-arrays data: sort one key array and permute any number of parallel arrays
+ * in lockstep, without packing them into structs.
+ */
+struct NUMERIC_API FNumericSort
+{
+	/** Radix passes, gathers and scatters give each worker thread at least this many elements. */
+	static constexpr int32 MinChunkNum = 16 * 1024;
+
+	/**
+	 * Returns the permutation that stably sorts Keys in ascending order, i.e. Keys[Result[0]] <= Keys[Result[1]] <= ...
+	 * Equal keys keep their relative order. Uses an LSD radix sort from ENumericThreshold::RadixSort elements.
+	 */
+	static TArray<int32> ArgSort(TArrayView<const int32> Keys);
+
+	/**
+	 * ArgSort down a fixed path, regardless of the dispatch table: the radix sort split into NumChunks ranges if bRadix,
+	 * otherwise a comparison sort. Used to time the paths against each other.
+	 */
+	static TArray<int32> ArgSort(TArrayView<const int32> Keys, bool bRadix, int32 NumChunks);
+
+	/**
+	 * Sorts plain values in ascending order, or descending if bDescending. Equal values are indistinguishable, so this
+	 * also serves the stable sorts. Uses an LSD radix sort from ENumericThreshold::RadixSortValues elements.
+	 */
+	static void Sort(TArrayView<int32> Values, bool bDescending = false);
+
+	/** Sort down a fixed path, regardless of the dispatch table. Used to time the paths against each other. */
+	static void Sort(TArrayView<int32> Values, bool bDescending, bool bRadix, int32 NumChunks);
+
+	/** Returns true if Permutation holds each index in [0, Permutation.Num()) exactly once. */
+	static bool IsPermutation(TArrayView<const int32> Permutation);
+
+	/** Returns Out with Out[i] = Source[Indices[i]]. Every index must be within Source. */
+	template <typename T>
+	static TArray<T> Gather(TArrayView<const T> Source, TArrayView<const int32> Indices)
+	{
+		TArray<T> Out;
+		Out.SetNumUninitialized(Indices.Num());
+		ForEachRange(Indices.Num(), [&Out, &Source, &Indices](int32 Begin, int32 End)
+		{
+			for (int32 i = Begin; i < End; ++i)
+			{
+				Out[i] = Source[Indices[i]];
+			}
+		});
+		return Out;
+	}
+
+	/** Returns Out with Out[Permutation[i]] = Source[i], the inverse of Gather. Permutation must be a permutation of Source's indices. */
+	template <typename T>
+	static TArray<T> Scatter(TArrayView<const T> Source, TArrayView<const int32> Permutation)
+	{
+		TArray<T> Out;
+		Out.SetNumUninitialized(Source.Num());
+		ForEachRange(Source.Num(), [&Out, &Source, &Permutation](int32 Begin, int32 End)
+		{
+			for (int32 i = Begin; i < End; ++i)
+			{
+				Out[Permutation[i]] = Source[i];
+			}
+		});
+		return Out;
+	}
+
+	/** Stably sorts Keys in ascending order and permutes every payload array in lockstep. Payloads must have as many elements as Keys. */
+	template <typename... PayloadTypes>
+	static void SortByKey(TArray<int32>& Keys, TArray<PayloadTypes>&... Payloads)
+	{
+		check(((Payloads.Num() == Keys.Num()) && ...));
+
+		const TArray<int32> Order = ArgSort(Keys);
+		Keys = Gather<int32>(Keys, Order);
+		((Payloads = Gather<PayloadTypes>(Payloads, Order)), ...);
+	}
+
+	/** Runs Body(Begin, End) over [0, Num), split across worker threads from ENumericThreshold::ParallelSort elements. */
+	template <typename BodyType>
+	static void ForEachRange(int32 Num, BodyType&& Body)
+	{
+		FNumericDispatch::ParallelRanges(Num, NumParallelChunks(Num), Forward<BodyType>(Body));
+	}
+
+	/** Returns how many chunks to split Num elements into: one per worker thread for large inputs, 1 otherwise. */
+	static int32 NumParallelChunks(int32 Num)
+	{
+		return FNumericDispatch::NumParallelChunks(ENumericThreshold::ParallelSort, Num, MinChunkNum);
+	}
+};
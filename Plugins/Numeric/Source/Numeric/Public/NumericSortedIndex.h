@@ -0,0 +1,40 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NumericSortedIndex.generated.h"
+
+/**
+ * Search index over a sorted int32 array, stored in Eytzinger (breadth-first) order.
+ *
+ * A plain binary search touches a new cache line at every level once the array outgrows the cache. In Eytzinger order
+ * the candidates of the next four levels share one cache line, so the search can prefetch them while it compares,
+ * which makes lookups into very large tables several times faster.
+ */
+USTRUCT(BlueprintType)
+struct NUMERIC_API FNumericSortedIndex
+{
+	GENERATED_BODY()
+
+	FNumericSortedIndex() = default;
+
+	/** Builds the index from an array sorted in ascending order. */
+	explicit FNumericSortedIndex(TArrayView<const int32> Sorted);
+
+	/** Number of indexed elements. */
+	int32 Num() const { return FMath::Max(Ranks.Num() - 1, 0); }
+
+	/** Returns the index in the original sorted array of the first element not less than Value, or Num() if there is none. */
+	int32 LowerBound(int32 Value) const;
+
+	/** Resolves many lookups at once, interleaving the searches so their memory accesses overlap. */
+	TArray<int32> LowerBound(TArrayView<const int32> Values) const;
+
+private:
+	/** Elements in Eytzinger order, 1-based. */
+	TArray<int32> Layout;
+
+	/** Position in the sorted array of each Layout slot, with Num() in slot 0 for "not found". */
+	TArray<int32> Ranks;
+};
@@ -0,0 +1,220 @@
+// © 2024 Maximo Comperatore. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+#include <array>
+
+/**
+ * Library kernels specialized for fixed-size arrays (std::array and TStaticArray).
+ *
+ * The size is a template parameter, so loops fully unroll: sorts become sorting networks of branchless compare-exchanges
+ * and reductions become balanced trees. Every kernel is constexpr, so lookup tables can be built at compile time:
+ *
+ *	constexpr auto Offsets = FNumericStatic::PartialSum(FNumericStatic::Iota<8>(1)); // {1, 3, 6, 10, 15, 21, 28, 36}
+ *
+ * TStaticArray's size cannot be deduced from a return type, so its Iota and Fill write into an existing array instead.
+ */
+struct FNumericStatic
+{
+	/** Returns an array filled with Value, Value + 1, ... */
+	template <SIZE_T N>
+	static constexpr std::array<int32, N> Iota(int32 Value)
+	{
+		std::array<int32, N> Result{};
+		for (SIZE_T i = 0; i < N; ++i)
+		{
+			Result[i] = Value + (int32)i;
+		}
+		return Result;
+	}
+
+	/** Returns an array filled with Value. */
+	template <SIZE_T N>
+	static constexpr std::array<int32, N> Fill(int32 Value)
+	{
+		std::array<int32, N> Result{};
+		for (SIZE_T i = 0; i < N; ++i)
+		{
+			Result[i] = Value;
+		}
+		return Result;
+	}
+
+	/** Returns the partial summed array. */
+	template <SIZE_T N>
+	static constexpr std::array<int32, N> PartialSum(std::array<int32, N> A)
+	{
+		PartialSumInPlace<N>(A);
+		return A;
+	}
+
+	/** Returns the array sorted in ascending order. */
+	template <SIZE_T N>
+	static constexpr std::array<int32, N> SortAscending(std::array<int32, N> A)
+	{
+		SortNetwork<N>(A, [](int32 X, int32 Y) { return X < Y; });
+		return A;
+	}
+
+	/** Returns the array sorted in descending order. */
+	template <SIZE_T N>
+	static constexpr std::array<int32, N> SortDescending(std::array<int32, N> A)
+	{
+		SortNetwork<N>(A, [](int32 X, int32 Y) { return X > Y; });
+		return A;
+	}
+
+	/** Returns the maximum value of the array. */
+	template <SIZE_T N>
+	static constexpr int32 ArrayMax(const std::array<int32, N>& A)
+	{
+		return Reduce<0, N>(A, [](int32 X, int32 Y) { return X < Y ? Y : X; });
+	}
+
+	/** Returns the minimum value of the array. */
+	template <SIZE_T N>
+	static constexpr int32 ArrayMin(const std::array<int32, N>& A)
+	{
+		return Reduce<0, N>(A, [](int32 X, int32 Y) { return Y < X ? Y : X; });
+	}
+
+	/** Returns the sum of all elements of the array. */
+	template <SIZE_T N>
+	static constexpr int32 Accumulate(const std::array<int32, N>& A)
+	{
+		return Reduce<0, N>(A, [](int32 X, int32 Y) { return X + Y; });
+	}
+
+	template <uint32 N, uint32 Alignment>
+	static constexpr void Iota(TStaticArray<int32, N, Alignment>& A, int32 Value)
+	{
+		for (uint32 i = 0; i < N; ++i)
+		{
+			A[i] = Value + (int32)i;
+		}
+	}
+
+	template <uint32 N, uint32 Alignment>
+	static constexpr void Fill(TStaticArray<int32, N, Alignment>& A, int32 Value)
+	{
+		for (uint32 i = 0; i < N; ++i)
+		{
+			A[i] = Value;
+		}
+	}
+
+	template <uint32 N, uint32 Alignment>
+	static constexpr TStaticArray<int32, N, Alignment> PartialSum(TStaticArray<int32, N, Alignment> A)
+	{
+		PartialSumInPlace<N>(A);
+		return A;
+	}
+
+	template <uint32 N, uint32 Alignment>
+	static constexpr TStaticArray<int32, N, Alignment> SortAscending(TStaticArray<int32, N, Alignment> A)
+	{
+		SortNetwork<N>(A, [](int32 X, int32 Y) { return X < Y; });
+		return A;
+	}
+
+	template <uint32 N, uint32 Alignment>
+	static constexpr TStaticArray<int32, N, Alignment> SortDescending(TStaticArray<int32, N, Alignment> A)
+	{
+		SortNetwork<N>(A, [](int32 X, int32 Y) { return X > Y; });
+		return A;
+	}
+
+	template <uint32 N, uint32 Alignment>
+	static constexpr int32 ArrayMax(const TStaticArray<int32, N, Alignment>& A)
+	{
+		return Reduce<0, N>(A, [](int32 X, int32 Y) { return X < Y ? Y : X; });
+	}
+
+	template <uint32 N, uint32 Alignment>
+	static constexpr int32 ArrayMin(const TStaticArray<int32, N, Alignment>& A)
+	{
+		return Reduce<0, N>(A, [](int32 X, int32 Y) { return Y < X ? Y : X; });
+	}
+
+	template <uint32 N, uint32 Alignment>
+	static constexpr int32 Accumulate(const TStaticArray<int32, N, Alignment>& A)
+	{
+		return Reduce<0, N>(A, [](int32 X, int32 Y) { return X + Y; });
+	}
+
+private:
+	template <SIZE_T N, typename ArrayType>
+	static constexpr void PartialSumInPlace(ArrayType& A)
+	{
+		for (SIZE_T i = 1; i < N; ++i)
+		{
+			A[i] += A[i - 1];
+		}
+	}
+
+	/** Balanced reduction tree over A[Begin, Begin + Count), which keeps independent operations in flight. */
+	template <SIZE_T Begin, SIZE_T Count, typename ArrayType, typename OpType>
+	static constexpr int32 Reduce(const ArrayType& A, OpType Op)
+	{
+		static_assert(Count > 0, "Cannot reduce an empty array");
+
+		if constexpr (Count == 1)
+		{
+			return A[Begin];
+		}
+		else
+		{
+			return Op(Reduce<Begin, Count / 2>(A, Op), Reduce<Begin + Count / 2, Count - Count / 2>(A, Op));
+		}
+	}
+
+	/**
+	 * Batcher's merge-exchange sort (Knuth, TAOCP 5.2.2 Algorithm M), valid for any N.
+	 * The comparisons depend only on N, so with a constant N the loops unroll into a straight-line network of
+	 * branchless compare-exchanges.
+	 */
+	template <SIZE_T N, typename ArrayType, typename PredicateType>
+	static constexpr void SortNetwork(ArrayType& A, PredicateType Predicate)
+	{
+		if constexpr (N > 1)
+		{
+			SIZE_T T = 0;
+			while (((SIZE_T)1 << T) < N)
+			{
+				++T;
+			}
+
+			for (SIZE_T P = (SIZE_T)1 << (T - 1); P > 0; P >>= 1)
+			{
+				SIZE_T Q = (SIZE_T)1 << (T - 1);
+				SIZE_T R = 0;
+				SIZE_T D = P;
+
+				for (;;)
+				{
+					for (SIZE_T i = 0; i + D < N; ++i)
+					{
+						if ((i & P) == R)
+						{
+							const int32 X = A[i];
+							const int32 Y = A[i + D];
+							const bool bSwap = Predicate(Y, X);
+							A[i] = bSwap ? Y : X;
+							A[i + D] = bSwap ? X : Y;
+						}
+					}
+
+					if (Q == P)
+					{
+						break;
+					}
+					D = Q - P;
+					Q >>= 1;
+					R = P;
+				}
+			}
+		}
+	}
+};